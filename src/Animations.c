@@ -184,9 +184,13 @@ struct AnimationData {
 	cc_uint16 statesCount;    /* Total number of animation frames */
 	cc_uint16 delay;          /* Delay in ticks until next frame is drawn */
 	cc_uint16 frameDelay;     /* Delay between each frame */
+	cc_bool uploaded;         /* Whether the current frame has been uploaded yet */
+	BitmapCol* frames;        /* Pixels of each frame, stored contiguously one after another */
 };
 
 static struct Bitmap anims_bmp;
+/* Frames of all animations, copied out of animations.png once validated */
+static BitmapCol* anims_frames;
 static struct AnimationData anims_list[ATLAS1D_MAX_ATLASES];
 static int anims_count;
 static cc_bool anims_validated, useLavaAnim, useWaterAnim, alwaysLavaAnim, alwaysWaterAnim;
@@ -258,14 +262,23 @@ static void Animations_Update(int texLoc, struct Bitmap* bmp, int stride) {
 	if (tex) Gfx_UpdateTexture(tex, 0, dstY, bmp, stride, Gfx.Mipmaps);
 }
 
+#ifndef CC_BUILD_WEB
+/* Whether the given tile currently has a texture that animation frames can be uploaded to */
+static cc_bool Animations_CanUpdate(int texLoc) {
+	return !Gfx.LostContext && Atlas1D.TexIds[Atlas1D_Index(texLoc)];
+}
+#endif
+
 static void Animations_Apply(struct AnimationData* data) {
 	struct Bitmap frame;
-	int loc, size;
+	int loc, size, state;
 	if (data->delay) { data->delay--; return; }
 
-	data->state++;
-	data->state %= data->statesCount;
-	data->delay  = data->frameDelay;
+	state       = (data->state + 1) % data->statesCount;
+	data->delay = data->frameDelay;
+	/* Single frame animations only ever need to be uploaded once */
+	if (state == data->state && data->uploaded) return;
+	data->state = state;
 
 	loc = data->texLoc;
 #ifndef CC_BUILD_WEB
@@ -275,6 +288,13 @@ static void Animations_Apply(struct AnimationData* data) {
 
 	size = data->frameSize;
 	Bitmap_Init(frame, size, size, NULL);
+	data->uploaded = true;
+
+	if (data->frames) {
+		frame.scan0 = data->frames + data->state * size * size;
+		Animations_Update(loc, &frame, size);
+		return;
+	}
 
 	frame.scan0 = anims_bmp.scan0 
 				+ data->frameY * anims_bmp.width
@@ -293,11 +313,53 @@ static cc_bool Animations_IsDefaultZip(void) {
 
 static void Animations_Clear(void) {
 	Mem_Free(anims_bmp.scan0);
+	Mem_Free(anims_frames);
 	anims_count = 0;
 	anims_bmp.scan0 = NULL;
+	anims_frames    = NULL;
 	anims_validated = false;
 }
 
+/* Copies each animation's frames out of animations.png, so that every frame is a contiguous */
+/*  block of pixels that can be uploaded directly, instead of first being copied out each tick */
+static void Animations_CacheFrames(void) {
+	struct AnimationData* data;
+	BitmapCol* dst;
+	BitmapCol* src;
+	int i, frame, y, size, total = 0;
+
+	for (i = 0; i < anims_count; i++) 
+	{
+		data   = &anims_list[i];
+		total += data->frameSize * data->frameSize * data->statesCount;
+	}
+	if (!total) return;
+
+	anims_frames = (BitmapCol*)Mem_TryAlloc(total, BITMAPCOLOR_SIZE);
+	if (!anims_frames) return;
+	dst = anims_frames;
+
+	for (i = 0; i < anims_count; i++) 
+	{
+		data = &anims_list[i];
+		size = data->frameSize;
+		data->frames = dst;
+
+		for (frame = 0; frame < data->statesCount; frame++) 
+		{
+			for (y = 0; y < size; y++, dst += size) 
+			{
+				src = Bitmap_GetRow(&anims_bmp, data->frameY + y) + data->frameX + frame * size;
+				Mem_Copy(dst, src, size * BITMAPCOLOR_SIZE);
+			}
+		}
+	}
+
+	/* animations.png is no longer needed once all frames have been copied */
+	Mem_Free(anims_bmp.scan0);
+	anims_bmp.scan0 = NULL;
+}
+
 static void Animations_Validate(void) {
 	struct AnimationData* data;
 	int maxX, maxY, tileX, tileY;
@@ -335,20 +397,24 @@ static void Animations_Validate(void) {
 
 static void Animations_Tick(struct ScheduledTask* task) {
 	int i;
+	/* deferred, because when reading animations.txt, might not have read animations.png yet */
+	if (anims_count && !anims_validated) {
+		if (!anims_bmp.scan0) {
+			Chat_AddRaw("&cCurrent texture pack specifies it uses animations,");
+			Chat_AddRaw("&cbut is missing animations.png");
+			anims_count = 0;
+		} else {
+			Animations_Validate();
+			Animations_CacheFrames();
+		}
+	}
+
 #ifndef CC_BUILD_WEB
-	if (useLavaAnim)  LavaAnimation_Tick();
-	if (useWaterAnim) WaterAnimation_Tick();
+	/* Skip simulating liquids when the result would just be discarded */
+	if (useLavaAnim  && Animations_CanUpdate(LAVA_TEX_LOC))  LavaAnimation_Tick();
+	if (useWaterAnim && Animations_CanUpdate(WATER_TEX_LOC)) WaterAnimation_Tick();
 #endif
 
-	if (!anims_count) return;
-	if (!anims_bmp.scan0) {
-		Chat_AddRaw("&cCurrent texture pack specifies it uses animations,");
-		Chat_AddRaw("&cbut is missing animations.png");
-		anims_count = 0; return;
-	}
-
-	/* deferred, because when reading animations.txt, might not have read animations.png yet */
-	if (!anims_validated) Animations_Validate();
 	for (i = 0; i < anims_count; i++) {
 		Animations_Apply(&anims_list[i]);
 	}
@@ -389,6 +455,14 @@ static void OnPackChanged(void* obj) {
 	alwaysLavaAnim  = false;
 	alwaysWaterAnim = false;
 }
+/* Terrain textures were recreated from terrain.png, so every animation's frame needs to be uploaded again */
+static void OnTexturesRecreated(void* obj) {
+	int i;
+	for (i = 0; i < anims_count; i++) {
+		anims_list[i].uploaded = false;
+	}
+}
+
 static void OnInit(void) {
 	TextureEntry_Register(&animations_entry);
 	TextureEntry_Register(&animations_txt);
@@ -396,7 +470,9 @@ static void OnInit(void) {
 	TextureEntry_Register(&lava_entry);
 
 	ScheduledTask_Add(GAME_DEF_TICKS, Animations_Tick);
-	Event_Register_(&TextureEvents.PackChanged, NULL, OnPackChanged);
+	Event_Register_(&TextureEvents.PackChanged,  NULL, OnPackChanged);
+	Event_Register_(&TextureEvents.AtlasChanged, NULL, OnTexturesRecreated);
+	Event_Register_(&GfxEvents.ContextRecreated, NULL, OnTexturesRecreated);
 }
 #else
 static void Animations_Clear(void) { }
@@ -13,6 +13,7 @@
 #include "Utils.h"
 #include "Options.h"
 #include "Deflate.h"
+#include "Camera.h"
 #ifdef CC_BUILD_MOBILE
 /* TODO: Refactor maybe to not rely on checking WinInfo.Handle != NULL */
 #include "Window.h"
@@ -44,7 +45,7 @@ static void Sounds_Start(void) {
 }
 
 void Audio_PlayDigSound(cc_uint8 type)  { }
-void Audio_PlayStepSound(cc_uint8 type) { }
+void Audio_PlayStepSound(cc_uint8 type, const Vec3* pos) { }
 
 void Sounds_LoadDefault(void) { }
 #else
@@ -169,7 +170,33 @@ CC_NOINLINE static void Sounds_Fail(cc_result res) {
 	Audio_SetSounds(0);
 }
 
-static void Sounds_Play(cc_uint8 type, struct Soundboard* board) {
+/* Sounds are played at full volume up to this distance, then fade out until the max distance */
+#define SOUNDS_FULL_DIST  8.0f
+#define SOUNDS_MAX_DIST  32.0f
+#define SOUNDS_MAX_PAN   60.0f
+
+/* Adjusts volume and stereo balance based on where the sound is relative to the listener */
+static void Sounds_SetPosition(struct AudioData* data, const Vec3* pos) {
+	Vec3 delta;
+	Vec2 rot;
+	float dist, pan;
+
+	Vec3_Sub(&delta, pos, &Camera.CurrentPos);
+	dist = Math_SqrtF(Vec3_LengthSquared(&delta));
+
+	if (dist >= SOUNDS_MAX_DIST) { data->volume = 0; return; }
+	if (dist > SOUNDS_FULL_DIST) {
+		data->volume = (int)(data->volume * (SOUNDS_MAX_DIST - dist) / (SOUNDS_MAX_DIST - SOUNDS_FULL_DIST));
+	}
+	if (dist < 0.001f) return;
+
+	/* project onto the camera's horizontal right vector */
+	rot = Camera.Active->GetOrientation();
+	pan = (delta.x * Math_CosF(rot.x) + delta.z * Math_SinF(rot.x)) / dist;
+	data->pan = (int)(pan * SOUNDS_MAX_PAN);
+}
+
+static void Sounds_Play(cc_uint8 type, struct Soundboard* board, const Vec3* pos) {
 	const struct Sound* snd;
 	struct AudioData data;
 	cc_result res;
@@ -183,6 +210,7 @@ static void Sounds_Play(cc_uint8 type, struct Soundboard* board) {
 	data.sampleRate = snd->sampleRate;
 	data.rate       = 100;
 	data.volume     = Audio_SoundsVolume;
+	data.pan        = 0;
 
 	/* https://minecraft.wiki/w/Block_of_Gold#Sounds */
 	/* https://minecraft.wiki/w/Grass#Sounds */
@@ -193,18 +221,24 @@ static void Sounds_Play(cc_uint8 type, struct Soundboard* board) {
 		data.volume /= 2;
 		if (type == SOUND_METAL) data.rate = 140;
 	}
+
+	if (pos) Sounds_SetPosition(&data, pos);
+	if (!data.volume) return;
 	
 	res = AudioPool_Play(&data);
 	if (res) Sounds_Fail(res);
 }
 
 static void Audio_PlayBlockSound(void* obj, IVec3 coords, BlockID old, BlockID now) {
+	Vec3 pos;
+	pos.x = coords.x + 0.5f; pos.y = coords.y + 0.5f; pos.z = coords.z + 0.5f;
+
 	if (now == BLOCK_AIR) {
-		Audio_PlayDigSound(Blocks.DigSounds[old]);
+		Sounds_Play(Blocks.DigSounds[old], &digBoard, &pos);
 	} else if (!Game_ClassicMode) {
 		/* use StepSounds instead when placing, as don't want */
 		/*  to play glass break sound when placing glass */
-		Audio_PlayDigSound(Blocks.StepSounds[now]);
+		Sounds_Play(Blocks.StepSounds[now], &digBoard, &pos);
 	}
 }
 
@@ -263,8 +297,8 @@ static void Sounds_Init(void) {
 }
 static void Sounds_Free(void) { Sounds_Stop(); }
 
-void Audio_PlayDigSound(cc_uint8 type)  { Sounds_Play(type, &digBoard); }
-void Audio_PlayStepSound(cc_uint8 type) { Sounds_Play(type, &stepBoard); }
+void Audio_PlayDigSound(cc_uint8 type)  { Sounds_Play(type, &digBoard,  NULL); }
+void Audio_PlayStepSound(cc_uint8 type, const Vec3* pos) { Sounds_Play(type, &stepBoard, pos); }
 #endif
 
 
@@ -1,6 +1,7 @@
 #ifndef CC_AUDIO_H
 #define CC_AUDIO_H
 #include "Core.h"
+#include "Vectors.h"
 /* Manages playing sound and music.
    Copyright 2014-2025 ClassiCube | Licensed under BSD-3
 */
@@ -35,6 +36,7 @@ struct AudioData {
 	int sampleRate; /* frequency / sample rate */
 	int volume; /* volume data played at (100 = normal volume) */
 	int rate;   /* speed/pitch played at (100 = normal speed) */
+	int pan;    /* stereo balance from -100 (left) to 100 (right), 0 = centred */
 };
 
 /* Volume sounds are played at, from 0-100. */
@@ -49,7 +51,8 @@ extern const cc_string Sounds_ZipPathCC;
 void Audio_SetMusic(int volume);
 void Audio_SetSounds(int volume);
 void Audio_PlayDigSound(cc_uint8 type);
-void Audio_PlayStepSound(cc_uint8 type);
+/* Plays a step sound coming from the given position, e.g. the feet of a local player */
+void Audio_PlayStepSound(cc_uint8 type, const Vec3* pos);
 #define AUDIO_MAX_BUFFERS 4
 
 cc_bool AudioBackend_Init(void);
@@ -0,0 +1,440 @@
+#include "Core.h"
+#ifdef CC_BUILD_BENCH
+#include "Benchmark.h"
+#include "Game.h"
+#include "String.h"
+#include "Stream.h"
+#include "Platform.h"
+#include "Logger.h"
+#include "Event.h"
+#include "World.h"
+#include "Lighting.h"
+#include "MapRenderer.h"
+#include "BlockPhysics.h"
+#include "Entity.h"
+#include "EntityComponents.h"
+#include "ExtMath.h"
+#include "Funcs.h"
+#include "Constants.h"
+#include "Generator.h"
+#include "Vorbis.h"
+#include "Errors.h"
+
+/* Number of times the neighbourhood of every chunk is read when comparing block layouts */
+#define BENCH_LAYOUT_PASSES 4
+/* Number of physics ticks timed (i.e. 10 seconds of singleplayer game time) */
+#define BENCH_PHYSICS_TICKS 200
+/* Fixed seed and size of the map generated to check parallel generation against serial generation */
+#define BENCH_GEN_SEED   1234
+#define BENCH_GEN_WIDTH  256
+#define BENCH_GEN_HEIGHT 64
+#define BENCH_GEN_LENGTH 256
+
+static int bench_loadMS;
+static cc_uint64 bench_loadBeg;
+static int bench_lightingUS, bench_lightingColumns;
+static int bench_chunksUS,   bench_chunksBuilt;
+static int bench_physicsUS;
+static int bench_genParallelMS, bench_genSerialMS;
+static cc_bool bench_genIdentical;
+static int bench_layoutChunks, bench_flatUS, bench_brickedUS;
+static cc_bool bench_layoutIdentical;
+static int bench_vorbisFiles, bench_vorbisAudioMS, bench_vorbisDecodeMS;
+static cc_uint32 bench_vorbisHash = 2166136261U;
+static int bench_frameUS[BENCH_FRAMES];
+/* Total time spent in each profiler stage over all frames */
+static cc_uint64 bench_stageUS[PROFILER_STAGES];
+
+
+/*########################################################################################################################*
+*-----------------------------------------------------------Stages--------------------------------------------------------*
+*#########################################################################################################################*/
+/* Generates a map using the classic generator, then returns a hash of its blocks */
+static cc_uint32 Bench_GenerateMap(cc_bool serial, int* elapsedMS) {
+	cc_uint64 beg = Stopwatch_Measure();
+	cc_uint32 hash = 2166136261U;
+	int i;
+
+	Gen_SerialBands = serial;
+	Gen_Active = &NotchyGen;
+	Gen_Seed   = BENCH_GEN_SEED;
+	Gen_Start();
+	while (!Gen_IsDone()) { Thread_Sleep(1); }
+
+	*elapsedMS = Stopwatch_ElapsedMS(beg, Stopwatch_Measure());
+	if (!Gen_Blocks) return 0;
+
+	/* FNV-1a hash */
+	for (i = 0; i < World.Volume; i++)
+	{
+		hash = (hash ^ Gen_Blocks[i]) * 16777619U;
+	}
+	Mem_Free(Gen_Blocks);
+	Gen_Blocks = NULL;
+	return hash;
+}
+
+/* Checks that generating noise bands on the worker pool produces exactly the same map as generating serially */
+static void Bench_Generator(void) {
+	int width = World.Width, height = World.Height, length = World.Length;
+	cc_uint32 parallel, serial;
+	World_SetDimensions(BENCH_GEN_WIDTH, BENCH_GEN_HEIGHT, BENCH_GEN_LENGTH);
+
+	parallel = Bench_GenerateMap(false, &bench_genParallelMS);
+	serial   = Bench_GenerateMap(true,  &bench_genSerialMS);
+	bench_genIdentical = parallel && parallel == serial;
+
+	if (!bench_genIdentical) Platform_LogConst("Parallel map generation differs from serial map generation!");
+	World_SetDimensions(width, height, length);
+}
+
+/* Decodes the given .ogg file as fast as possible, adding its output samples to the running hash */
+static void Bench_DecodeOgg(const cc_string* path, void* obj, int isDirectory) {
+	static const cc_string oggExt = String_FromConst(".ogg");
+	struct VorbisState* vorbis;
+	struct OggState* ogg;
+	struct Stream stream;
+	cc_uint64 beg, samples = 0;
+	cc_int16* data;
+	cc_result res;
+	int i, count;
+
+	if (isDirectory) { Directory_Enum(path, obj, Bench_DecodeOgg); return; }
+	if (!String_CaselessEnds(path, &oggExt)) return;
+	if (Stream_OpenFile(&stream, path)) return;
+
+	vorbis = (struct VorbisState*)Mem_AllocCleared(1, sizeof(struct VorbisState), "bench vorbis");
+	ogg   = (struct OggState*)Mem_AllocCleared(1, sizeof(struct OggState), "bench ogg");
+	data   = NULL;
+	beg    = Stopwatch_Measure();
+
+	Ogg_Init(ogg, &stream);
+	Vorbis_Init(vorbis);
+	vorbis->source = ogg;
+	if ((res = Vorbis_DecodeHeaders(vorbis))) goto cleanup;
+	data = (cc_int16*)Mem_Alloc(vorbis->channels * vorbis->blockSizes[1], 2, "bench samples");
+
+	while (!(res = Vorbis_DecodeFrame(vorbis)))
+	{
+		count = Vorbis_OutputFrame(vorbis, data);
+		/* FNV-1a hash, so that optimisations can be checked to produce identical output */
+		for (i = 0; i < count; i++)
+		{
+			bench_vorbisHash = (bench_vorbisHash ^ (cc_uint16)data[i]) * 16777619U;
+		}
+		samples += count;
+	}
+
+	bench_vorbisDecodeMS += Stopwatch_ElapsedMS(beg, Stopwatch_Measure());
+	bench_vorbisAudioMS  += (int)(samples * 1000 / (vorbis->channels * vorbis->sampleRate));
+	bench_vorbisFiles++;
+
+cleanup:
+	if (res && res != ERR_END_OF_STREAM) Logger_SimpleWarn2(res, "decoding", path);
+	Vorbis_Free(vorbis);
+	Mem_Free(vorbis);
+	Mem_Free(ogg);
+	Mem_Free(data);
+	(void)stream.Close(&stream);
+}
+
+/* Decodes all the music files, to measure how many times faster than real-time vorbis decoding is */
+static void Bench_Vorbis(void) {
+	static const cc_string audioDir = String_FromConst("audio");
+	Directory_Enum(&audioDir, NULL, Bench_DecodeOgg);
+}
+
+/* The map is only loaded once, by the singleplayer connection in Game_Setup */
+/* NOTE: These are registered before Game_Setup, so they run before any other handlers of these events */
+static void Bench_OnNewMap(void* obj) {
+	bench_loadBeg = Stopwatch_Measure();
+}
+
+static void Bench_OnMapLoaded(void* obj) {
+	bench_loadMS = Stopwatch_ElapsedMS(bench_loadBeg, Stopwatch_Measure());
+}
+
+/* Index of a block in a copy of the map that is split into 16x16x16 bricks, with each brick stored contiguously */
+#define Bench_BrickIndex(x, y, z) ((World_ChunkPack((x) >> CHUNK_SHIFT, (y) >> CHUNK_SHIFT, (z) >> CHUNK_SHIFT) << 12) \
+								| (((y) & CHUNK_MASK) << 8) | (((z) & CHUNK_MASK) << 4) | ((x) & CHUNK_MASK))
+
+static BlockRaw* Bench_MakeBricked(void) {
+	BlockRaw* bricks = (BlockRaw*)Mem_AllocCleared(World.ChunksCount, CHUNK_SIZE_3, "bench bricks");
+	int x, y, z;
+
+	for (y = 0; y < World.Height; y++)
+		for (z = 0; z < World.Length; z++)
+			for (x = 0; x < World.Width; x++)
+	{
+		bricks[Bench_BrickIndex(x, y, z)] = World.Blocks[World_Pack(x, y, z)];
+	}
+	return bricks;
+}
+
+/* Reads the 18x18x18 neighbourhood of blocks around a chunk, in the same order as Builder's ReadChunkData */
+/* Returns a hash of the blocks read, so the two layouts can be checked to read the same blocks */
+static cc_uint32 Bench_ReadFlat(int x1, int y1, int z1) {
+	cc_uint32 hash = 2166136261U;
+	int xx, yy, zz, index;
+
+	for (yy = -1; yy < 17; yy++)
+		for (zz = -1; zz < 17; zz++)
+	{
+		index = World_Pack(x1 - 1, y1 + yy, z1 + zz);
+		for (xx = -1; xx < 17; xx++, index++)
+		{
+			hash = (hash ^ World.Blocks[index]) * 16777619U;
+		}
+	}
+	return hash;
+}
+
+static cc_uint32 Bench_ReadBricked(BlockRaw* bricks, int x1, int y1, int z1) {
+	cc_uint32 hash = 2166136261U;
+	int xx, yy, zz, y, z, index;
+
+	for (yy = -1; yy < 17; yy++)
+		for (zz = -1; zz < 17; zz++)
+	{
+		y = y1 + yy; z = z1 + zz;
+		hash  = (hash ^ bricks[Bench_BrickIndex(x1 - 1, y, z)]) * 16777619U;
+
+		/* Row of the chunk itself is contiguous within its brick */
+		index = Bench_BrickIndex(x1, y, z);
+		for (xx = 0; xx < 16; xx++, index++)
+		{
+			hash = (hash ^ bricks[index]) * 16777619U;
+		}
+		hash  = (hash ^ bricks[Bench_BrickIndex(x1 + 16, y, z)]) * 16777619U;
+	}
+	return hash;
+}
+
+/* Compares reading the blocks needed to build every chunk from the flat y-major map array, */
+/*  against reading them from a bricked copy of the map. (only chunks not touching the map edges) */
+static void Bench_BlockLayout(void) {
+	BlockRaw* bricks = Bench_MakeBricked();
+	cc_uint32 flatHash = 0, brickedHash = 0;
+	cc_uint64 beg;
+	int cx, cy, cz, pass;
+	bench_layoutChunks = 0;
+
+	beg = Stopwatch_Measure();
+	for (pass = 0; pass < BENCH_LAYOUT_PASSES; pass++)
+		for (cy = 1; (cy + 1) * CHUNK_SIZE < World.Height; cy++)
+			for (cz = 1; (cz + 1) * CHUNK_SIZE < World.Length; cz++)
+				for (cx = 1; (cx + 1) * CHUNK_SIZE < World.Width; cx++)
+	{
+		flatHash += Bench_ReadFlat(cx << CHUNK_SHIFT, cy << CHUNK_SHIFT, cz << CHUNK_SHIFT);
+		bench_layoutChunks++;
+	}
+	bench_flatUS = (int)Stopwatch_ElapsedMicroseconds(beg, Stopwatch_Measure());
+
+	beg = Stopwatch_Measure();
+	for (pass = 0; pass < BENCH_LAYOUT_PASSES; pass++)
+		for (cy = 1; (cy + 1) * CHUNK_SIZE < World.Height; cy++)
+			for (cz = 1; (cz + 1) * CHUNK_SIZE < World.Length; cz++)
+				for (cx = 1; (cx + 1) * CHUNK_SIZE < World.Width; cx++)
+	{
+		brickedHash += Bench_ReadBricked(bricks, cx << CHUNK_SHIFT, cy << CHUNK_SHIFT, cz << CHUNK_SHIFT);
+	}
+	bench_brickedUS = (int)Stopwatch_ElapsedMicroseconds(beg, Stopwatch_Measure());
+
+	bench_layoutChunks   /= BENCH_LAYOUT_PASSES;
+	bench_layoutIdentical = flatHash == brickedHash;
+	Mem_Free(bricks);
+}
+
+static void Bench_Lighting(void) {
+	cc_uint64 beg = Stopwatch_Measure();
+	int cx, cy, cz;
+	Lighting.Refresh();
+
+	/* Same regions that are lit when building each chunk */
+	for (cz = 0; cz < World.ChunksZ; cz++)
+		for (cx = 0; cx < World.ChunksX; cx++)
+			for (cy = 0; cy < World.ChunksY; cy++)
+	{
+		Lighting.LightHint(cx * CHUNK_SIZE - 1, cy * CHUNK_SIZE - 1, cz * CHUNK_SIZE - 1);
+	}
+
+	bench_lightingUS      = (int)Stopwatch_ElapsedMicroseconds(beg, Stopwatch_Measure());
+	bench_lightingColumns = World.ChunksX * World.ChunksZ;
+}
+
+static void Bench_BuildChunks(void) {
+	cc_uint64 beg = Stopwatch_Measure();
+	bench_chunksBuilt = MapRenderer_BuildAllChunks();
+	bench_chunksUS    = (int)Stopwatch_ElapsedMicroseconds(beg, Stopwatch_Measure());
+
+	/* Camera path should measure chunks being built as they come into view too */
+	MapRenderer_Refresh();
+}
+
+static void Bench_Physics(void) {
+	cc_uint64 beg;
+	int i;
+	Physics_SetEnabled(true);
+
+	beg = Stopwatch_Measure();
+	for (i = 0; i < BENCH_PHYSICS_TICKS; i++) { Physics_Tick(); }
+	bench_physicsUS = (int)Stopwatch_ElapsedMicroseconds(beg, Stopwatch_Measure());
+}
+
+/* Moves the camera to the given point on a circle around the centre of the map, facing inwards */
+static void Bench_MoveCamera(int frame) {
+	struct Entity* e = &Entities.CurPlayer->Base;
+	struct LocationUpdate update;
+	float angle  = (float)frame / BENCH_FRAMES * 2.0f * MATH_PI;
+	float radius = min(World.Width, World.Length) * 0.375f;
+
+	update.flags = LU_HAS_POS | LU_HAS_PITCH | LU_HAS_YAW;
+	update.pos.x = World.Width  * 0.5f - radius * Math_SinF(angle);
+	update.pos.y = World.Height * 0.75f;
+	update.pos.z = World.Length * 0.5f + radius * Math_CosF(angle);
+	update.yaw   = angle * MATH_RAD2DEG;
+	update.pitch = 20.0f;
+
+	Vec3_Set(e->Velocity, 0, 0, 0);
+	e->VTABLE->SetLocation(e, &update);
+}
+
+static void Bench_CameraPath(void) {
+	cc_uint64 beg;
+	int i, j;
+	HacksComp_SetFlying(&Entities.CurPlayer->Hacks, true);
+	Profiler_SetEnabled(true);
+
+	for (i = 0; i < BENCH_FRAMES && Game_Running; i++)
+	{
+		Bench_MoveCamera(i);
+		beg = Stopwatch_Measure();
+		Game_RenderFrame();
+		bench_frameUS[i] = (int)Stopwatch_ElapsedMicroseconds(beg, Stopwatch_Measure());
+
+		for (j = 0; j < PROFILER_STAGES; j++)
+		{
+			bench_stageUS[j] += Profiler.Times[Profiler.Frame][j];
+		}
+	}
+	Profiler_SetEnabled(false);
+}
+
+
+/*########################################################################################################################*
+*-----------------------------------------------------------Results-------------------------------------------------------*
+*#########################################################################################################################*/
+static void SortFrameTimes(int left, int right) {
+	int* keys = bench_frameUS; int key;
+
+	while (left < right) {
+		int i = left, j = right;
+		int pivot = keys[(i + j) >> 1];
+
+		/* partition the list */
+		while (i <= j) {
+			while (pivot > keys[i]) i++;
+			while (pivot < keys[j]) j--;
+			QuickSort_Swap_Maybe();
+		}
+		/* recurse into the smaller subset */
+		QuickSort_Recurse(SortFrameTimes)
+	}
+}
+
+/* Returns the frame time that the given percent of frames took less than or equal to */
+static int FramePercentile(int percent) {
+	return bench_frameUS[(BENCH_FRAMES - 1) * percent / 100];
+}
+
+static void Bench_FormatResults(cc_string* str) {
+	int frames = BENCH_FRAMES, ticks = BENCH_PHYSICS_TICKS;
+	int p50, p90, p99, p100, avg, i;
+	cc_uint64 total = 0;
+
+	for (i = 0; i < BENCH_FRAMES; i++) { total += bench_frameUS[i]; }
+	avg = (int)(total / BENCH_FRAMES);
+	SortFrameTimes(0, BENCH_FRAMES - 1);
+
+	p50  = FramePercentile(50); p90  = FramePercentile(90);
+	p99  = FramePercentile(99); p100 = FramePercentile(100);
+
+	String_AppendConst(str, "{\n");
+	String_Format4(str, "  \"map\": {\"width\":%i,\"height\":%i,\"length\":%i,\"load_ms\":%i},\n",
+					&World.Width, &World.Height, &World.Length, &bench_loadMS);
+	String_Format2(str, "  \"lighting\": {\"columns\":%i,\"total_us\":%i},\n",
+					&bench_lightingColumns, &bench_lightingUS);
+
+	i = bench_chunksUS ? (int)((cc_uint64)bench_chunksBuilt * 1000000 / bench_chunksUS) : 0;
+	String_Format3(str, "  \"chunk_build\": {\"chunks\":%i,\"total_us\":%i,\"chunks_per_sec\":%i},\n",
+					&bench_chunksBuilt, &bench_chunksUS, &i);
+	String_Format4(str, "  \"block_layout\": {\"chunks\":%i,\"flat_us\":%i,\"bricked_us\":%i,\"identical\":%c},\n",
+					&bench_layoutChunks, &bench_flatUS, &bench_brickedUS, bench_layoutIdentical ? "true" : "false");
+	String_Format2(str, "  \"physics\": {\"ticks\":%i,\"total_us\":%i},\n",
+					&ticks, &bench_physicsUS);
+	String_Format3(str, "  \"generator\": {\"parallel_ms\":%i,\"serial_ms\":%i,\"identical\":%c},\n",
+					&bench_genParallelMS, &bench_genSerialMS, bench_genIdentical ? "true" : "false");
+
+	i = bench_vorbisDecodeMS ? bench_vorbisAudioMS / bench_vorbisDecodeMS : 0;
+	String_Format4(str, "  \"vorbis\": {\"files\":%i,\"audio_ms\":%i,\"decode_ms\":%i,\"realtime_factor\":%i,",
+					&bench_vorbisFiles, &bench_vorbisAudioMS, &bench_vorbisDecodeMS, &i);
+	String_Format1(str, "\"hash\":\"%h\"},\n", &bench_vorbisHash);
+
+	String_AppendConst(str, "  \"stages_avg_us\": {");
+	for (i = 0; i < PROFILER_STAGES; i++)
+	{
+		int stage = (int)(bench_stageUS[i] / BENCH_FRAMES);
+		String_Format2(str, "\"%c\":%i", Profiler_Names[i], &stage);
+		if (i < PROFILER_STAGES - 1) String_Append(str, ',');
+	}
+	String_AppendConst(str, "},\n");
+
+	String_Format2(str, "  \"frames\": {\"count\":%i,\"avg_us\":%i,", &frames, &avg);
+	String_Format4(str, "\"p50_us\":%i,\"p90_us\":%i,\"p99_us\":%i,\"max_us\":%i}\n",
+					&p50, &p90, &p99, &p100);
+	String_AppendConst(str, "}\n");
+}
+
+static cc_result Bench_WriteResults(const cc_string* path) {
+	cc_string str; char strBuffer[2048];
+	struct Stream stream;
+	cc_result res, closeRes;
+
+	String_InitArray(str, strBuffer);
+	Bench_FormatResults(&str);
+
+	res = Stream_CreateFile(&stream, path);
+	if (res) return res;
+
+	res      = Stream_Write(&stream, (cc_uint8*)str.buffer, str.length);
+	closeRes = stream.Close(&stream);
+	return res ? res : closeRes;
+}
+
+void Benchmark_Run(const cc_string* outputPath) {
+	cc_result res;
+	Event_Register_(&WorldEvents.NewMap,    NULL, Bench_OnNewMap);
+	Event_Register_(&WorldEvents.MapLoaded, NULL, Bench_OnMapLoaded);
+
+	Game_Setup();
+	Game_SetFpsLimit(FPS_LIMIT_NONE);
+
+	if (!World.Blocks) Logger_FailToStart("Failed to load benchmark map");
+
+	Bench_Generator();
+	Bench_Vorbis();
+	Bench_Lighting();
+	Bench_BuildChunks();
+	Bench_BlockLayout();
+	Bench_Physics();
+	Bench_CameraPath();
+
+	res = Bench_WriteResults(outputPath);
+	if (res) {
+		Logger_SysWarn2(res, "writing benchmark results to", outputPath);
+	} else {
+		Platform_Log1("Benchmark results written to %s", outputPath);
+	}
+	Game_Free();
+}
+#endif
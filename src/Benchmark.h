@@ -0,0 +1,24 @@
+#ifndef CC_BENCHMARK_H
+#define CC_BENCHMARK_H
+#include "Core.h"
+/*
+Headless benchmark of the map loading, lighting, chunk building and rendering pipeline
+  Loads SP_AutoloadMap (which must be set), flies the camera along a fixed path at a fixed timestep,
+  then writes the timings of each stage as JSON
+Copyright 2014-2025 ClassiCube | Licensed under BSD-3
+*/
+CC_BEGIN_HEADER
+
+/* Number of frames rendered along the camera path */
+#define BENCH_FRAMES 600
+/* Fixed timestep (in microseconds) that each benchmark frame advances the game by */
+#define BENCH_FRAME_MICROS (1000000 / 60)
+/* Fixed resolution that benchmark frames are rendered at */
+#define BENCH_WIDTH  640
+#define BENCH_HEIGHT 360
+
+/* Runs the benchmark, then writes the results to the given file */
+void Benchmark_Run(const cc_string* outputPath);
+
+CC_END_HEADER
+#endif
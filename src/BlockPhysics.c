@@ -14,6 +14,7 @@
 #include "Vectors.h"
 #include "Chat.h"
 #include "Audio.h"
+#include "Utils.h"
 
 /* Data for a resizable queue, used for liquid physic tick entries. */
 struct TickQueue {
@@ -92,6 +93,10 @@ static RNGState physics_rnd;
 static int physics_tickCount;
 static int physics_maxWaterX, physics_maxWaterY, physics_maxWaterZ;
 static struct TickQueue lavaQ, waterQ;
+/* Scratch buffers used when ticking a large water queue */
+static cc_uint32* physics_items;
+static cc_uint8*  physics_spongeMasks;
+static int physics_itemsCapacity;
 
 #define PHYSICS_DELAY_MASK 0xF8000000UL
 #define PHYSICS_POS_MASK   0x07FFFFFFUL
@@ -100,16 +105,30 @@ static struct TickQueue lavaQ, waterQ;
 #define PHYSICS_LAVA_DELAY (30U << PHYSICS_DELAY_SHIFT)
 #define PHYSICS_WATER_DELAY (5U << PHYSICS_DELAY_SHIFT)
 
+static void Physics_FreeScratch(void) {
+	Mem_Free(physics_items);
+	Mem_Free(physics_spongeMasks);
+	physics_items         = NULL;
+	physics_spongeMasks   = NULL;
+	physics_itemsCapacity = 0;
+}
+
 static void Physics_OnNewMapLoaded(void* obj) {
 	TickQueue_Clear(&lavaQ);
 	TickQueue_Clear(&waterQ);
+	Physics_FreeScratch();
 
 	physics_maxWaterX = World.MaxX - 2;
 	physics_maxWaterY = World.MaxY - 2;
 	physics_maxWaterZ = World.MaxZ - 2;
 
 	Tree_Blocks = World.Blocks;
+#ifdef CC_BUILD_BENCH
+	/* Benchmark must perform the same random ticks every run */
+	Random_Seed(&physics_rnd, 0);
+#else
 	Random_SeedFromCurrentTime(&physics_rnd);
+#endif
 	Tree_Rnd = &physics_rnd;
 }
 
@@ -368,43 +387,72 @@ static void Physics_PlaceWater(int index, BlockID block) {
 	TickQueue_Enqueue(&waterQ, PHYSICS_WATER_DELAY | index);
 }
 
-static void Physics_PropagateWater(int posIndex, int x, int y, int z) {
+/* Whether water spreading into the given position would be soaked up by a nearby sponge */
+static cc_bool Physics_IsSponged(int posIndex, int x, int y, int z) {
 	BlockID block = World.Blocks[posIndex];
 	int xx, yy, zz;
 
+	/* Water only ever spreads into non-liquid gas blocks */
+	if (block >= BLOCK_WATER && block <= BLOCK_STILL_LAVA) return false;
+	if (Blocks.Collide[block] != COLLIDE_NONE) return false;
+
+	for (yy = (y < 2 ? 0 : y - 2); yy <= (y > physics_maxWaterY ? World.MaxY : y + 2); yy++) {
+		for (zz = (z < 2 ? 0 : z - 2); zz <= (z > physics_maxWaterZ ? World.MaxZ : z + 2); zz++) {
+			for (xx = (x < 2 ? 0 : x - 2); xx <= (x > physics_maxWaterX ? World.MaxX : x + 2); xx++) {
+				block = World_GetBlock(xx, yy, zz);
+				if (block == BLOCK_SPONGE) return true;
+			}
+		}
+	}
+	return false;
+}
+
+/* Calculates which neighbours of the given water block are prevented from flooding by sponges */
+/* NOTE: Only reads from the world, so is safe to call from worker threads */
+static int Physics_CalcSpongeMask(int index) {
+	int x, y, z, mask = 0;
+	World_Unpack(index, x, y, z);
+
+	if (x > 0          && Physics_IsSponged(index - 1,           x - 1, y,     z    )) mask |= 0x01;
+	if (x < World.MaxX && Physics_IsSponged(index + 1,           x + 1, y,     z    )) mask |= 0x02;
+	if (z > 0          && Physics_IsSponged(index - World.Width, x,     y,     z - 1)) mask |= 0x04;
+	if (z < World.MaxZ && Physics_IsSponged(index + World.Width, x,     y,     z + 1)) mask |= 0x08;
+	if (y > 0          && Physics_IsSponged(index - World.OneY,  x,     y - 1, z    )) mask |= 0x10;
+	return mask;
+}
+
+static void Physics_PropagateWater(int posIndex, int x, int y, int z, int sponged) {
+	BlockID block = World.Blocks[posIndex];
+
 	if (block >= BLOCK_WATER && block <= BLOCK_STILL_LAVA) {
 		/* Water spreading into lava turns the lava solid */
 		if (block == BLOCK_LAVA || block == BLOCK_STILL_LAVA) {
 			Game_UpdateBlock(x, y, z, BLOCK_STONE);
 		}
 	} else if (Blocks.Collide[block] == COLLIDE_NONE) {
-		/* Sponge check */		
-		for (yy = (y < 2 ? 0 : y - 2); yy <= (y > physics_maxWaterY ? World.MaxY : y + 2); yy++) {
-			for (zz = (z < 2 ? 0 : z - 2); zz <= (z > physics_maxWaterZ ? World.MaxZ : z + 2); zz++) {
-				for (xx = (x < 2 ? 0 : x - 2); xx <= (x > physics_maxWaterX ? World.MaxX : x + 2); xx++) {
-					block = World_GetBlock(xx, yy, zz);
-					if (block == BLOCK_SPONGE) return;
-				}
-			}
-		}
+		if (sponged) return;
 
 		TickQueue_Enqueue(&waterQ, PHYSICS_WATER_DELAY | posIndex);
 		Game_UpdateBlock(x, y, z, BLOCK_WATER);
 	}
 }
 
-static void Physics_ActivateWater(int index, BlockID block) {
+static void Physics_SpreadWater(int index, int spongeMask) {
 	int x, y, z;
 	World_Unpack(index, x, y, z);
 
-	if (x > 0)          Physics_PropagateWater(index - 1,           x - 1, y,     z);
-	if (x < World.MaxX) Physics_PropagateWater(index + 1,           x + 1, y,     z);
-	if (z > 0)          Physics_PropagateWater(index - World.Width, x,     y,     z - 1);
-	if (z < World.MaxZ) Physics_PropagateWater(index + World.Width, x,     y,     z + 1);
-	if (y > 0)          Physics_PropagateWater(index - World.OneY,  x,     y - 1, z);
+	if (x > 0)          Physics_PropagateWater(index - 1,           x - 1, y,     z,     spongeMask & 0x01);
+	if (x < World.MaxX) Physics_PropagateWater(index + 1,           x + 1, y,     z,     spongeMask & 0x02);
+	if (z > 0)          Physics_PropagateWater(index - World.Width, x,     y,     z - 1, spongeMask & 0x04);
+	if (z < World.MaxZ) Physics_PropagateWater(index + World.Width, x,     y,     z + 1, spongeMask & 0x08);
+	if (y > 0)          Physics_PropagateWater(index - World.OneY,  x,     y - 1, z,     spongeMask & 0x10);
 }
 
-static void Physics_TickWater(void) {
+static void Physics_ActivateWater(int index, BlockID block) {
+	Physics_SpreadWater(index, Physics_CalcSpongeMask(index));
+}
+
+static void Physics_TickWaterSerial(void) {
 	int i, count = waterQ.count;
 	for (i = 0; i < count; i++) {
 		int index;
@@ -416,6 +464,64 @@ static void Physics_TickWater(void) {
 	}
 }
 
+/* Number of water queue entries processed per worker pool job */
+#define PHYSICS_JOB_SIZE 4096
+
+static void Physics_SpongeMasksJob(int job, void* obj) {
+	int i   = job * PHYSICS_JOB_SIZE;
+	int end = min(i + PHYSICS_JOB_SIZE, *((int*)obj));
+
+	for (; i < end; i++) {
+		cc_uint32 item = physics_items[i];
+		/* Delayed entries are just requeued, so don't need a mask */
+		if (item >= PHYSICS_ONE_DELAY) continue;
+		physics_spongeMasks[i] = Physics_CalcSpongeMask((int)(item & PHYSICS_POS_MASK));
+	}
+}
+
+/* Ticks a large water queue in two passes: */
+/*  1) The sponge checks (125 block lookups per neighbour) are calculated on worker threads */
+/*  2) The entries are then applied on the main thread, in the exact same order as the serial path */
+/* Sponges can't be placed or removed while the water queue is ticking, so the precomputed */
+/*  sponge masks always match what the serial path would calculate, keeping results deterministic. */
+static void Physics_TickWaterParallel(void) {
+	int i, index, count = waterQ.count;
+	cc_uint32 item;
+	BlockID block;
+
+	if (count > physics_itemsCapacity) {
+		Physics_FreeScratch();
+		physics_items       = (cc_uint32*)Mem_Alloc(count, 4, "physics items");
+		physics_spongeMasks = (cc_uint8*) Mem_Alloc(count, 1, "physics sponge masks");
+		physics_itemsCapacity = count;
+	}
+
+	for (i = 0; i < count; i++) {
+		physics_items[i] = TickQueue_Dequeue(&waterQ);
+	}
+	WorkerPool_Run(Physics_SpongeMasksJob, &count, (count + PHYSICS_JOB_SIZE - 1) / PHYSICS_JOB_SIZE);
+
+	for (i = 0; i < count; i++) {
+		item = physics_items[i];
+		if (item >= PHYSICS_ONE_DELAY) {
+			TickQueue_Enqueue(&waterQ, item - PHYSICS_ONE_DELAY); continue;
+		}
+
+		index = (int)(item & PHYSICS_POS_MASK);
+		block = World.Blocks[index];
+		if (!(block == BLOCK_WATER || block == BLOCK_STILL_WATER)) continue;
+		Physics_SpreadWater(index, physics_spongeMasks[i]);
+	}
+}
+
+static void Physics_TickWater(void) {
+	if (waterQ.count >= PHYSICS_JOB_SIZE * 2) {
+		Physics_TickWaterParallel();
+	} else {
+		Physics_TickWaterSerial();
+	}
+}
+
 
 static void Physics_PlaceSponge(int index, BlockID block) {
 	int x, y, z, xx, yy, zz;
@@ -560,6 +666,7 @@ void Physics_Init(void) {
 
 void Physics_Free(void) {
 	Event_Unregister_(&WorldEvents.MapLoaded,    NULL, Physics_OnNewMapLoaded);
+	Physics_FreeScratch();
 }
 
 void Physics_Tick(void) {
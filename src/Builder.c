@@ -51,6 +51,11 @@ struct Builder1DPart {
 The first ATLAS1D_MAX_ATLASES parts are for normal parts, remainder are for translucent parts. */
 static CC_BIG_VAR struct Builder1DPart Builder_Parts[ATLAS1D_MAX_ATLASES * 2];
 static struct VertexTextured* Builder_Vertices;
+#ifdef CC_BUILD_COMPACTCHUNKS
+/* Vertices are built into this buffer first, then packed into the chunk's vertex buffer */
+static struct VertexTextured* Builder_Staging;
+static int Builder_StagingCount;
+#endif
 
 static int Builder1DPart_VerticesCount(struct Builder1DPart* part) {
 	int i, count = part->sCount;
@@ -127,6 +132,42 @@ static void BuildPartVbs(struct ChunkPartInfo* info) {
 }
 #endif
 
+#ifdef CC_BUILD_COMPACTCHUNKS
+static struct VertexTextured* GetStagingVertices(int count) {
+	if (count > Builder_StagingCount) {
+		Mem_Free(Builder_Staging);
+		Builder_Staging      = (struct VertexTextured*)Mem_Alloc(count, sizeof(struct VertexTextured), "chunk vertices");
+		Builder_StagingCount = count;
+	}
+	return Builder_Staging;
+}
+
+/* Quantises a texture coordinate, clamping to within [0, 65535] */
+/* NOTE: Rounds down so that UV2_Scale insets stay inside the tile, */
+/*  with a small bias so float error doesn't round exact values down */
+static CC_INLINE int PackCoord(float value, float scale) {
+	int packed = (int)(value * scale + (1.0f / 64.0f));
+	return packed < 0 ? 0 : (packed > 0xFFFF ? 0xFFFF : packed);
+}
+
+/* Converts the built vertices into compact chunk vertices, relative to the chunk's origin */
+static void PackChunkVertices(struct VertexChunk* dst, int count, int x1, int y1, int z1) {
+	struct VertexTextured* src = Builder_Vertices;
+	int i;
+
+	for (i = 0; i < count; i++, src++, dst++)
+	{
+		dst->x   = (cc_int16)Math_Floor((src->x - x1) * CHUNKVERT_POS_SCALE + 0.5f);
+		dst->y   = (cc_int16)Math_Floor((src->y - y1) * CHUNKVERT_POS_SCALE + 0.5f);
+		dst->z   = (cc_int16)Math_Floor((src->z - z1) * CHUNKVERT_POS_SCALE + 0.5f);
+		dst->w   = 0;
+		dst->Col = src->Col;
+		dst->U   = (cc_uint16)PackCoord(src->U, CHUNKVERT_U_SCALE);
+		dst->V   = (cc_uint16)PackCoord(src->V, CHUNKVERT_V_SCALE);
+	}
+}
+#endif
+
 static cc_bool SetPartInfo(struct Builder1DPart* part, int* offset, struct ChunkPartInfo* info) {
 	int vCount = Builder1DPart_VerticesCount(part);
 	info->offset = -1;
@@ -146,12 +187,61 @@ static cc_bool SetPartInfo(struct Builder1DPart* part, int* offset, struct Chunk
 }
 
 
+/* Index of the given row (relative to chunk origin) in the per-row bitmasks */
+#define Builder_PackRow(yy, zz) (((yy) + 1) * EXTCHUNK_SIZE + ((zz) + 1))
+
+/* Computes a bitmask for each row along X of the extended chunk, */
+/*  where bit (xx + 1) is set when that block is full opaque and inside the world */
+static void ComputeOpaqueRows(int x1, int y1, int z1, cc_uint32* rows) {
+	cc_uint32 inWorld = 0, mask;
+	int cIndex, x, y, z, xx, yy, zz;
+
+	for (xx = -1; xx <= CHUNK_SIZE; xx++) 
+	{
+		x = x1 + xx;
+		if (x >= 0 && x < World.Width) inWorld |= 1u << (xx + 1);
+	}
+
+	for (yy = -1; yy <= CHUNK_SIZE; yy++) {
+		for (zz = -1; zz <= CHUNK_SIZE; zz++) {
+			y = y1 + yy; z = z1 + zz;
+			mask = 0;
+
+			if (y >= 0 && y < World.Height && z >= 0 && z < World.Length) {
+				cIndex = Builder_PackChunk(-1, yy, zz);
+
+				for (xx = 0; xx < EXTCHUNK_SIZE; xx++, cIndex++) 
+				{
+					mask |= (cc_uint32)Blocks.FullOpaque[Builder_Chunk[cIndex]] << xx;
+				}
+			}
+			rows[Builder_PackRow(yy, zz)] = mask & inWorld;
+		}
+	}
+}
+
+/* Computes which faces of blocks in the given row are hidden by a full opaque neighbour */
+/*  when the block itself is also full opaque (i.e. Blocks.Hidden would be 0x3F for the pair) */
+/* NOTE: Bit (xx + 1) of each mask corresponds to the block at xx */
+static void ComputeHiddenFaces(const cc_uint32* rows, int yy, int zz, cc_uint32* faces) {
+	cc_uint32 self = rows[Builder_PackRow(yy, zz)];
+
+	faces[FACE_XMIN] = self & (self << 1);
+	faces[FACE_XMAX] = self & (self >> 1);
+	faces[FACE_ZMIN] = self & rows[Builder_PackRow(yy, zz - 1)];
+	faces[FACE_ZMAX] = self & rows[Builder_PackRow(yy, zz + 1)];
+	faces[FACE_YMIN] = self & rows[Builder_PackRow(yy - 1, zz)];
+	faces[FACE_YMAX] = self & rows[Builder_PackRow(yy + 1, zz)];
+}
+
 static void PrepareChunk(int x1, int y1, int z1) {
 	int xMax = min(World.Width,  x1 + CHUNK_SIZE);
 	int yMax = min(World.Height, y1 + CHUNK_SIZE);
 	int zMax = min(World.Length, z1 + CHUNK_SIZE);
 
-	int cIndex, index, tileIdx;
+	cc_uint32 opaqueRows[EXTCHUNK_SIZE * EXTCHUNK_SIZE];
+	cc_uint32 rowFaces[FACE_COUNT], allHidden;
+	int cIndex, index, tileIdx, hidden, bit;
 	BlockID b;
 	int x, y, z, xx, yy, zz;
 
@@ -168,15 +258,30 @@ static void PrepareChunk(int x1, int y1, int z1) {
 	map.SunlightZSide = map.ShadowlightZSide = col;
 	map.SunlightYBottom = map.ShadowlightYBottom = col;
 #endif
+
+	/* Faces between two full opaque blocks are always hidden, so work those out for */
+	/*  whole rows at once using bitmasks, rather than looking up Blocks.Hidden per face */
+	ComputeOpaqueRows(x1, y1, z1, opaqueRows);
 	
 	for (y = y1, yy = 0; y < yMax; y++, yy++) {
 		for (z = z1, zz = 0; z < zMax; z++, zz++) {
 			cIndex = Builder_PackChunk(0, yy, zz);
+			ComputeHiddenFaces(opaqueRows, yy, zz, rowFaces);
+
+			allHidden = rowFaces[FACE_XMIN] & rowFaces[FACE_XMAX] & rowFaces[FACE_ZMIN] 
+					  & rowFaces[FACE_ZMAX] & rowFaces[FACE_YMIN] & rowFaces[FACE_YMAX];
 
 			for (x = x1, xx = 0; x < xMax; x++, xx++, cIndex++) {
+				index = Builder_PackCount(xx, yy, zz);
+				bit   = xx + 1;
+
+				/* Block is completely surrounded by full opaque blocks */
+				if (allHidden & (1u << bit)) {
+					Mem_Set(&Builder_Counts[index], 0, FACE_COUNT); continue;
+				}
+
 				b = Builder_Chunk[cIndex];
 				if (Blocks.Draw[b] == DRAW_GAS) continue;
-				index = Builder_PackCount(xx, yy, zz);
 
 				/* Sprites can't be stretched, nor can then be they hidden by other blocks. */
 				/* Note sprites are drawn using DrawSprite and not with any of the DrawXFace. */
@@ -185,9 +290,12 @@ static void PrepareChunk(int x1, int y1, int z1) {
 				Builder_X = x; Builder_Y = y; Builder_Z = z;
 				Builder_FullBright = Blocks.Brightness[b];
 				tileIdx = b * BLOCK_COUNT;
+				hidden  = ((rowFaces[FACE_XMIN] >> bit) & 1) << FACE_XMIN | ((rowFaces[FACE_XMAX] >> bit) & 1) << FACE_XMAX
+						| ((rowFaces[FACE_ZMIN] >> bit) & 1) << FACE_ZMIN | ((rowFaces[FACE_ZMAX] >> bit) & 1) << FACE_ZMAX
+						| ((rowFaces[FACE_YMIN] >> bit) & 1) << FACE_YMIN | ((rowFaces[FACE_YMAX] >> bit) & 1) << FACE_YMAX;
 				/* All of these function calls are inlined as they can be called tens of millions to hundreds of millions of times. */
 
-				if (Builder_Counts[index] == 0 ||
+				if ((hidden & FACE_BIT_XMIN) || Builder_Counts[index] == 0 ||
 					(x == 0 && (y < Builder_SidesLevel || (b >= BLOCK_WATER && b <= BLOCK_STILL_LAVA && y < Builder_EdgeLevel))) ||
 					(x != 0 && (Blocks.Hidden[tileIdx + Builder_Chunk[cIndex - 1]] & FACE_BIT_XMIN) != 0)) {
 					Builder_Counts[index] = 0;
@@ -196,7 +304,7 @@ static void PrepareChunk(int x1, int y1, int z1) {
 				}
 
 				index++;
-				if (Builder_Counts[index] == 0 ||
+				if ((hidden & FACE_BIT_XMAX) || Builder_Counts[index] == 0 ||
 					(x == World.MaxX && (y < Builder_SidesLevel || (b >= BLOCK_WATER && b <= BLOCK_STILL_LAVA && y < Builder_EdgeLevel))) ||
 					(x != World.MaxX && (Blocks.Hidden[tileIdx + Builder_Chunk[cIndex + 1]] & FACE_BIT_XMAX) != 0)) {
 					Builder_Counts[index] = 0;
@@ -205,7 +313,7 @@ static void PrepareChunk(int x1, int y1, int z1) {
 				}
 
 				index++;
-				if (Builder_Counts[index] == 0 ||
+				if ((hidden & FACE_BIT_ZMIN) || Builder_Counts[index] == 0 ||
 					(z == 0 && (y < Builder_SidesLevel || (b >= BLOCK_WATER && b <= BLOCK_STILL_LAVA && y < Builder_EdgeLevel))) ||
 					(z != 0 && (Blocks.Hidden[tileIdx + Builder_Chunk[cIndex - EXTCHUNK_SIZE]] & FACE_BIT_ZMIN) != 0)) {
 					Builder_Counts[index] = 0;
@@ -214,7 +322,7 @@ static void PrepareChunk(int x1, int y1, int z1) {
 				}
 
 				index++;
-				if (Builder_Counts[index] == 0 ||
+				if ((hidden & FACE_BIT_ZMAX) || Builder_Counts[index] == 0 ||
 					(z == World.MaxZ && (y < Builder_SidesLevel || (b >= BLOCK_WATER && b <= BLOCK_STILL_LAVA && y < Builder_EdgeLevel))) ||
 					(z != World.MaxZ && (Blocks.Hidden[tileIdx + Builder_Chunk[cIndex + EXTCHUNK_SIZE]] & FACE_BIT_ZMAX) != 0)) {
 					Builder_Counts[index] = 0;
@@ -223,7 +331,7 @@ static void PrepareChunk(int x1, int y1, int z1) {
 				}
 
 				index++;
-				if (Builder_Counts[index] == 0 || y == 0 ||
+				if ((hidden & FACE_BIT_YMIN) || Builder_Counts[index] == 0 || y == 0 ||
 					(Blocks.Hidden[tileIdx + Builder_Chunk[cIndex - EXTCHUNK_SIZE_2]] & FACE_BIT_YMIN) != 0) {
 					Builder_Counts[index] = 0;
 				} else {
@@ -231,7 +339,7 @@ static void PrepareChunk(int x1, int y1, int z1) {
 				}
 
 				index++;
-				if (Builder_Counts[index] == 0 ||
+				if ((hidden & FACE_BIT_YMAX) || Builder_Counts[index] == 0 ||
 					(Blocks.Hidden[tileIdx + Builder_Chunk[cIndex + EXTCHUNK_SIZE_2]] & FACE_BIT_YMAX) != 0) {
 					Builder_Counts[index] = 0;
 				} else if (b < BLOCK_WATER || b > BLOCK_STILL_LAVA) {
@@ -271,13 +379,10 @@ static cc_bool ReadChunkData(int x1, int y1, int z1, cc_bool* outAllAir) {
 #ifndef EXTENDED_BLOCKS
 	ReadChunkBody(blocks[index]);
 #else
-	BlockRaw* blocks2;
-
 	if (World.IDMask <= 0xFF) {
 		ReadChunkBody(blocks[index]);
 	} else {
-		blocks2 = World.Blocks2;
-		ReadChunkBody(blocks[index] | (blocks2[index] << 8));
+		ReadChunkBody(World_GetRawBlock(index));
 	}
 #endif
 
@@ -313,7 +418,6 @@ for (yy = -1; yy < 17; ++yy) {\
 
 static cc_bool ReadBorderChunkData(int x1, int y1, int z1, cc_bool* outAllAir) {
 	BlockRaw* blocks = World.Blocks;
-	BlockRaw* blocks2;
 	cc_bool allAir = true;
 	int index, cIndex;
 	BlockID block;
@@ -325,8 +429,7 @@ static cc_bool ReadBorderChunkData(int x1, int y1, int z1, cc_bool* outAllAir) {
 	if (World.IDMask <= 0xFF) {
 		ReadBorderChunkBody(blocks[index]);
 	} else {
-		blocks2 = World.Blocks2;
-		ReadBorderChunkBody(blocks[index] | (blocks2[index] << 8));
+		ReadBorderChunkBody(World_GetRawBlock(index));
 	}
 #endif
 
@@ -420,7 +523,9 @@ void Builder_MakeChunk(struct ChunkInfo* info) {
 		info.occlusionFlags = (cc_uint8)ComputeOcclusion();
 #endif
 
-#if CC_GFX_BACKEND != CC_GFX_BACKEND_GL11
+#if defined CC_BUILD_COMPACTCHUNKS
+	Builder_Vertices = GetStagingVertices(totalVerts);
+#elif CC_GFX_BACKEND != CC_GFX_BACKEND_GL11
 	/* add an extra element to fix crashing on some GPUs */
 	info->vb = Gfx_CreateVb(VERTEX_FORMAT_TEXTURED, totalVerts + 1);
 	Builder_Vertices = (struct VertexTextured*)Gfx_LockVb(info->vb,
@@ -457,6 +562,12 @@ void Builder_MakeChunk(struct ChunkInfo* info) {
 		BuildPartVbs(&MapRenderer_PartsNormal[curIdx]);
 		BuildPartVbs(&MapRenderer_PartsTranslucent[curIdx]);
 	}
+#elif defined CC_BUILD_COMPACTCHUNKS
+	/* add an extra element to fix crashing on some GPUs */
+	info->vb = Gfx_CreateVb(VERTEX_FORMAT_CHUNK, totalVerts + 1);
+	PackChunkVertices((struct VertexChunk*)Gfx_LockVb(info->vb, VERTEX_FORMAT_CHUNK, totalVerts + 1),
+						totalVerts, x1, y1, z1);
+	Gfx_UnlockVb(info->vb);
 #else
 	Gfx_UnlockVb(info->vb);
 #endif
@@ -1654,6 +1765,14 @@ static void OnInit(void) {
 	Builder_ApplyActive();
 }
 
+static void OnFree(void) {
+#ifdef CC_BUILD_COMPACTCHUNKS
+	Mem_Free(Builder_Staging);
+	Builder_Staging      = NULL;
+	Builder_StagingCount = 0;
+#endif
+}
+
 static void OnNewMapLoaded(void) {
 	Builder_SidesLevel = max(0, Env_SidesHeight);
 	Builder_EdgeLevel  = max(0, Env.EdgeHeight);
@@ -1661,7 +1780,7 @@ static void OnNewMapLoaded(void) {
 
 struct IGameComponent Builder_Component = {
 	OnInit, /* Init */
-	NULL, /* Free */
+	OnFree, /* Free */
 	NULL, /* Reset */
 	NULL, /* OnNewMap */
 	OnNewMapLoaded /* OnNewMapLoaded */
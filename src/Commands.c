@@ -182,6 +182,31 @@ static struct ChatCommand GpuInfoCommand = {
 	}
 };
 
+static void ProfilerCommand_Execute(const cc_string* args, int argsCount) {
+	static const cc_string path = String_FromConst("profiler-trace.json");
+	cc_result res;
+
+	if (argsCount && String_CaselessEqualsConst(args, "trace")) {
+		res = Profiler_WriteTrace(&path);
+		if (res) { Logger_SysWarn2(res, "writing", &path); return; }
+		Chat_Add1("&e/client: &fSaved recent frame times to %s", &path);
+	} else {
+		Profiler_SetEnabled(!Profiler.Enabled);
+		Chat_AddRaw(Profiler.Enabled ? "&e/client: &fFrame profiler &aenabled" : "&e/client: &fFrame profiler &cdisabled");
+	}
+}
+
+static struct ChatCommand ProfilerCommand = {
+	"Profiler", ProfilerCommand_Execute,
+	COMMAND_FLAG_UNSPLIT_ARGS,
+	{
+		"&a/client profiler [trace]",
+		"&eToggles the frame time graph. (also toggled by Shift + Hide FPS key)",
+		"&etrace: &fSaves recently recorded frame times to profiler-trace.json",
+		"&e  Can be viewed using chrome://tracing or ui.perfetto.dev",
+	}
+};
+
 static void RenderTypeCommand_Execute(const cc_string* args, int argsCount) {
 	int flags;
 	if (!argsCount) {
@@ -798,6 +823,7 @@ static struct ChatCommand BlockEditCommand = {
 *#########################################################################################################################*/
 static void OnInit(void) {
 	Commands_Register(&GpuInfoCommand);
+	Commands_Register(&ProfilerCommand);
 	Commands_Register(&HelpCommand);
 	Commands_Register(&RenderTypeCommand);
 	Commands_Register(&ResolutionCommand);
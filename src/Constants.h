@@ -7,7 +7,7 @@ Copyright 2014-2025 ClassiCube | Licensed under BSD-3
 
 #define GAME_MAX_CMDARGS 5
 #define GAME_APP_VER "1.3.7"
-#define GAME_API_VER 1
+#define GAME_API_VER 2
 
 #if defined CC_BUILD_WEB
 #define GAME_APP_ALT   "ClassiCube 1.3.7 web mobile"
@@ -795,6 +795,9 @@ static void LocalPlayer_OnNewMap(struct LocalPlayer* p) {
 
 static void LocalPlayers_OnNewMap(void) {
 	int i;
+	/* Chunk state from the old map is no longer valid */
+	Searcher_Free();
+
 	for (i = 0; i < Game_NumStates; i++)
 	{
 		LocalPlayer_OnNewMap(&LocalPlayer_Instances[i]);
@@ -1148,7 +1148,7 @@ void SoundComp_Tick(struct LocalPlayer* p, cc_bool wasOnGround) {
 	if (!sounds_anyNonAir) soundPos = Vec3_BigPos();
 
 	if (p->Base.OnGround && (SoundComp_ShouldPlay(p, soundPos) || !wasOnGround)) {
-		Audio_PlayStepSound(sounds_type);
+		Audio_PlayStepSound(sounds_type, &p->Base.next.pos);
 		sounds_lastPos = soundPos;
 	}
 }
@@ -409,7 +409,7 @@ static int CalcRainHeightAt(int x, int maxY, int z, int hIndex) {
 	if (World.IDMask <= 0xFF) {
 		RainCalcBody(World.Blocks[i]);
 	} else {
-		RainCalcBody(World.Blocks[i] | (World.Blocks2[i] << 8));
+		RainCalcBody(World_GetRawBlock(i));
 	}
 #endif
 
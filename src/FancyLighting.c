@@ -101,8 +101,7 @@ static void FreePalettes(void) {
 }
 
 static int chunksCount;
-static void AllocState(void) {
-	ClassicLighting_AllocState();
+static void AllocFancyState(void) {
 	InitPalettes();
 	chunksCount = World.ChunksCount;
 
@@ -112,10 +111,8 @@ static void AllocState(void) {
 	Queue_Init(&unlightQueue, sizeof(struct LightNode));
 }
 
-static void FreeState(void) {
+static void FreeFancyState(void) {
 	int i;
-	ClassicLighting_FreeState();
-	
 	/* This function can be called multiple times without calling AllocState, so... */
 	if (!chunkLightingDataFlags) return;
 
@@ -133,6 +130,16 @@ static void FreeState(void) {
 	Queue_Clear(&unlightQueue);
 }
 
+static void AllocState(void) {
+	ClassicLighting_AllocState();
+	AllocFancyState();
+}
+
+static void FreeState(void) {
+	ClassicLighting_FreeState();
+	FreeFancyState();
+}
+
 /* Converts chunk x/y/z coordinates to the corresponding index in chunks array/list */
 #define ChunkCoordsToIndex(cx, cy, cz) (((cy) * World.ChunksZ + (cz)) * World.ChunksX + (cx))
 /* Converts local x/y/z coordinates to the corresponding index in a chunk */
@@ -472,9 +479,10 @@ static void OnBlockChanged(int x, int y, int z, BlockID oldBlock, BlockID newBlo
 /* Invalidates/Resets lighting state for all of the blocks in the world */
 /*  (e.g. because a block changed whether it is full bright or not) */
 static void Refresh(void) {
+	/* Heightmap columns are only reset here, and get recalculated lazily as chunks are rebuilt */
 	ClassicLighting_Refresh();
-	FreeState();
-	AllocState();
+	FreeFancyState();
+	AllocFancyState();
 }
 static cc_bool IsLit(int x, int y, int z) { return ClassicLighting_IsLit(x, y, z); }
 static cc_bool IsLit_Fast(int x, int y, int z) { return ClassicLighting_IsLit_Fast(x, y, z); }
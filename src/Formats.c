@@ -516,18 +516,29 @@ static BlockRaw* Nbt_TakeArray(struct NbtTag* tag, const char* type) {
 	return ptr;
 }
 
+#if CC_BUILD_MAXSTACK <= (16 * 1024)
+	#define NBT_BUFFER_SIZE 1024
+#else
+	#define NBT_BUFFER_SIZE 8192
+#endif
+
 static cc_result Nbt_Read(struct Stream* stream, Nbt_Callback callback) {
-	struct Stream compStream;
+	struct Stream compStream, bufStream;
 	struct InflateState state;
+	cc_uint8 buffer[NBT_BUFFER_SIZE];
 	cc_result res;
 	cc_uint8 tag;
 
 	Inflate_MakeStream2(&compStream, &state, stream);
 	if ((res = Map_SkipGZipHeader(stream))) return res;
-	if ((res = compStream.ReadU8(&compStream, &tag))) return res;
+
+	/* Most tags are only a few bytes, so decompress in larger blocks and parse them from memory */
+	/*  (large arrays such as BlockArray bypass the buffer and are decompressed directly into place) */
+	Stream_ReadonlyBuffered(&bufStream, &compStream, buffer, sizeof(buffer));
+	if ((res = bufStream.ReadU8(&bufStream, &tag))) return res;
 
 	if (tag != NBT_DICT) return CW_ERR_ROOT_TAG;
-	return Nbt_ReadTag(NBT_DICT, true, &compStream, NULL, callback, 0);
+	return Nbt_ReadTag(NBT_DICT, true, &bufStream, NULL, callback, 0);
 }
 
 
@@ -1571,6 +1582,24 @@ static cc_result Cw_WriteBockDef(struct Stream* stream, int b) {
 	return Stream_Write(stream, buffer, (int)(cur - buffer));
 }
 
+#ifdef EXTENDED_BLOCKS
+/* Writes out the upper 8 bits of all blocks, treating unallocated pages as all 0 */
+static cc_result Cw_WriteUpper(struct Stream* stream) {
+	static const BlockRaw zeroes[WORLD_UPPER_PAGE_SIZE] = { 0 };
+	const BlockRaw* page;
+	cc_result res;
+	int i, len;
+
+	for (i = 0; i < World.Volume; i += WORLD_UPPER_PAGE_SIZE) 
+	{
+		page = World.Blocks2Pages[i >> WORLD_UPPER_SHIFT];
+		len  = min(WORLD_UPPER_PAGE_SIZE, World.Volume - i);
+		if ((res = Stream_Write(stream, page ? page : zeroes, len))) return res;
+	}
+	return 0;
+}
+#endif
+
 cc_result Cw_Save(struct Stream* stream) {
 	struct LocalPlayer* p = Entities.CurPlayer;
 	cc_uint8 buffer[2048];
@@ -1607,12 +1636,12 @@ cc_result Cw_Save(struct Stream* stream) {
 	if ((res = Stream_Write(stream, World.Blocks, World.Volume)))  return res;
 
 #ifdef EXTENDED_BLOCKS
-	if (World.Blocks != World.Blocks2) {
+	if (World.Blocks2Pages) {
 		cur = buffer;
 		cur = Nbt_WriteArray(cur, "BlockArray2", World.Volume);
 
 		if ((res = Stream_Write(stream, buffer, (int)(cur - buffer)))) return res;
-		if ((res = Stream_Write(stream, World.Blocks2, World.Volume))) return res;
+		if ((res = Cw_WriteUpper(stream))) return res;
 	}
 #endif
 
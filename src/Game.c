@@ -41,6 +41,7 @@
 #include "SystemFonts.h"
 #include "Formats.h"
 #include "EntityRenderers.h"
+#include "Benchmark.h"
 
 struct _GameData Game;
 static cc_uint64 frameStart;
@@ -104,6 +105,126 @@ int ScheduledTask_Add(double interval, ScheduledTaskCallback callback) {
 }
 
 
+/*########################################################################################################################*
+*---------------------------------------------------------Profiler--------------------------------------------------------*
+*#########################################################################################################################*/
+struct _ProfilerData Profiler;
+const char* const Profiler_Names[PROFILER_STAGES] = {
+	"Input", "Server", "Entities", "Ticks", "Chunks", "World", "GUI", "Present", "Idle"
+};
+
+/* Every stage that was timed is also kept in a ring buffer, for Profiler_WriteTrace */
+#define PROFILER_MAX_EVENTS 8192
+/* Stage used for events that span a whole frame */
+#define PROFILER_FRAME_EVENT PROFILER_STAGES
+struct ProfilerEvent { cc_uint64 beg, end; int stage; };
+
+static struct ProfilerEvent* prof_events;
+static int prof_eventsHead, prof_eventsCount;
+static int prof_stage;
+static cc_uint64 prof_stageBeg, prof_frameBeg;
+
+static void Profiler_AddEvent(int stage, cc_uint64 beg, cc_uint64 end) {
+	struct ProfilerEvent* e;
+	if (!prof_events) return;
+
+	e = &prof_events[prof_eventsHead];
+	e->beg = beg; e->end = end; e->stage = stage;
+
+	prof_eventsHead = (prof_eventsHead + 1) % PROFILER_MAX_EVENTS;
+	if (prof_eventsCount < PROFILER_MAX_EVENTS) prof_eventsCount++;
+}
+
+void Profiler_SetEnabled(cc_bool enabled) {
+	if (enabled == Profiler.Enabled) return;
+	Profiler.Enabled = enabled;
+	if (!enabled) return;
+
+	if (!prof_events) {
+		prof_events = (struct ProfilerEvent*)Mem_TryAlloc(PROFILER_MAX_EVENTS, sizeof(struct ProfilerEvent));
+	}
+	prof_eventsHead  = 0;
+	prof_eventsCount = 0;
+	Mem_Set(Profiler.Times, 0, sizeof(Profiler.Times));
+
+	prof_stage    = PROFILER_IDLE;
+	prof_stageBeg = Stopwatch_Measure();
+	prof_frameBeg = prof_stageBeg;
+}
+
+void Profiler_Switch(int stage) {
+	cc_uint64 now = Stopwatch_Measure();
+	Profiler.Times[Profiler.Frame][prof_stage] += (int)Stopwatch_ElapsedMicroseconds(prof_stageBeg, now);
+	Profiler_AddEvent(prof_stage, prof_stageBeg, now);
+
+	prof_stage    = stage;
+	prof_stageBeg = now;
+}
+
+static void Profiler_NextFrame(void) {
+	Profiler_Switch(PROFILER_INPUT);
+	Profiler_AddEvent(PROFILER_FRAME_EVENT, prof_frameBeg, prof_stageBeg);
+	prof_frameBeg = prof_stageBeg;
+
+	Profiler.Frame = (Profiler.Frame + 1) % PROFILER_FRAMES;
+	Mem_Set(Profiler.Times[Profiler.Frame], 0, sizeof(Profiler.Times[0]));
+}
+
+static cc_result Profiler_WriteEvents(struct Stream* s) {
+	cc_string str; char strBuffer[2048];
+	struct ProfilerEvent* e;
+	cc_uint64 base;
+	const char* name;
+	int i, j, ts, dur;
+	cc_result res;
+
+	/* Frame events start before the stage events recorded just before them */
+	i    = (prof_eventsHead - prof_eventsCount + PROFILER_MAX_EVENTS) % PROFILER_MAX_EVENTS;
+	base = prof_eventsCount ? prof_events[i].beg : 0;
+	for (j = 0; j < prof_eventsCount; j++)
+	{
+		e = &prof_events[(i + j) % PROFILER_MAX_EVENTS];
+		if (e->beg < base) base = e->beg;
+	}
+
+	String_InitArray(str, strBuffer);
+	String_AppendConst(&str, "{\"traceEvents\":[\n");
+
+	for (j = 0; j < prof_eventsCount; j++)
+	{
+		e    = &prof_events[(i + j) % PROFILER_MAX_EVENTS];
+		name = e->stage == PROFILER_FRAME_EVENT ? "Frame" : Profiler_Names[e->stage];
+		ts   = (int)Stopwatch_ElapsedMicroseconds(base,   e->beg);
+		dur  = (int)Stopwatch_ElapsedMicroseconds(e->beg, e->end);
+
+		String_Format3(&str, "{\"name\":\"%c\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%i,\"dur\":%i}",
+						name, &ts, &dur);
+		String_AppendConst(&str, j < prof_eventsCount - 1 ? ",\n" : "\n");
+
+		/* Flush when buffer is close to full */
+		if (str.length < str.capacity - 256) continue;
+		res = Stream_Write(s, (cc_uint8*)str.buffer, str.length);
+		if (res) return res;
+		str.length = 0;
+	}
+
+	String_AppendConst(&str, "]}\n");
+	return Stream_Write(s, (cc_uint8*)str.buffer, str.length);
+}
+
+cc_result Profiler_WriteTrace(const cc_string* path) {
+	struct Stream stream;
+	cc_result res, closeRes;
+
+	res = Stream_CreateFile(&stream, path);
+	if (res) return res;
+
+	res      = Profiler_WriteEvents(&stream);
+	closeRes = stream.Close(&stream);
+	return res ? res : closeRes;
+}
+
+
 void Game_ToggleFullscreen(void) {
 	int state = Window_GetWindowState();
 	cc_result res;
@@ -205,6 +326,7 @@ void Game_UpdateBlock(int x, int y, int z, BlockID block) {
 	}
 	Lighting.OnBlockChanged(x, y, z, old, block);
 	MapRenderer_OnBlockChanged(x, y, z, block);
+	Searcher_OnBlockChanged(x, y, z);
 }
 
 void Game_ChangeBlock(int x, int y, int z, BlockID block) {
@@ -516,6 +638,7 @@ static void Render3DFrame(float delta, float t) {
 	struct Matrix mvp;
 	Vec3 pos;
 
+	Profiler_Mark(PROFILER_WORLD);
 	Camera.Active->GetView(&Gfx.View);
 	/*Gfx_LoadMatrix(MATRIX_PROJ, &Gfx.Projection);
 	Gfx_LoadMatrix(MATRIX_VIEW, &Gfx.View);
@@ -525,14 +648,20 @@ static void Render3DFrame(float delta, float t) {
 
 	if (EnvRenderer_ShouldRenderSkybox()) EnvRenderer_RenderSkybox();
 	AxisLinesRenderer_Render();
+
+	Profiler_Mark(PROFILER_ENTITIES);
 	Entities_RenderModels(delta, t);
 	EntityNames_Render();
 
+	Profiler_Mark(PROFILER_WORLD);
 	Particles_Render(t);
 	EnvRenderer_RenderSky();
 	EnvRenderer_RenderClouds();
 
+	Profiler_Mark(PROFILER_CHUNKS);
 	MapRenderer_Update(delta);
+
+	Profiler_Mark(PROFILER_WORLD);
 	MapRenderer_RenderNormal(delta);
 	EnvRenderer_RenderMapSides();
 
@@ -582,6 +711,10 @@ static void PerformScheduledTasks(double time) {
 	for (i = 0; i < tasksCount; i++) {
 		task = &tasks[i];
 		task->accumulator += time;
+		if (task->accumulator < task->interval) continue;
+
+		Profiler_Mark(i == entTaskI ? PROFILER_ENTITIES : 
+			(task->Callback == Server.Tick ? PROFILER_SERVER : PROFILER_TICKS));
 
 		while (task->accumulator >= task->interval) {
 			task->Callback(task);
@@ -681,6 +814,8 @@ static void LimitFPS(void) {
 static CC_INLINE void Game_DrawFrame(float delta, float t) {
 	int i;
 
+	/* Picking and camera updates belong to rendering the world, not to the ticks before them */
+	Profiler_Mark(PROFILER_WORLD);
 	if (!Gui_GetBlocksWorld()) {
 		Camera.Active->GetPickedBlock(&Game_SelectedPos); /* TODO: only pick when necessary */
 		Camera_KeyLookUpdate(delta);
@@ -695,6 +830,7 @@ static CC_INLINE void Game_DrawFrame(float delta, float t) {
 		RayTracer_SetInvalid(&Game_SelectedPos);
 	}
 
+	Profiler_Mark(PROFILER_GUI);
 	Gfx_Begin2D(Game.Width, Game.Height);
 	Gui_RenderGui(delta);
 	for (i = 0; i < Array_Elems(Game.Draw2DHooks); i++)
@@ -744,10 +880,17 @@ void Game_RenderFrame(void) {
 	double deltaD;
 	float t, delta;
 
-	cc_uint64 render  = Stopwatch_Measure();
-	cc_uint64 elapsed = Stopwatch_ElapsedMicroseconds(frameStart, render);
+	cc_uint64 render, elapsed;
+	if (Profiler.Enabled) Profiler_NextFrame();
+
+	render  = Stopwatch_Measure();
+	elapsed = Stopwatch_ElapsedMicroseconds(frameStart, render);
 	/* avoid large delta with suspended process */
 	if (elapsed > 5000000) elapsed = 5000000;
+#ifdef CC_BUILD_BENCH
+	/* Benchmark always advances by a fixed timestep, so every run does the same work */
+	elapsed = BENCH_FRAME_MICROS;
+#endif
 	
 	deltaD = (int)elapsed / (1000.0 * 1000.0);
 	delta  = (float)deltaD;
@@ -803,6 +946,7 @@ void Game_RenderFrame(void) {
 	t = (float)(entTask.accumulator / entTask.interval);
 	LocalPlayer_SetInterpPosition(Entities.CurPlayer, t);
 
+	Profiler_Mark(PROFILER_TICKS);
 	Camera.CurrentPos = Camera.Active->GetPosition(t);
 	/* NOTE: EnvRenderer_UpdateFog also also sets clear color */
 	EnvRenderer_UpdateFog();
@@ -839,7 +983,10 @@ void Game_RenderFrame(void) {
 #endif
 
 	if (Game_ScreenshotRequested) Game_TakeScreenshot();
+	Profiler_Mark(PROFILER_PRESENT);
 	Gfx_EndFrame();
+
+	Profiler_Mark(PROFILER_IDLE);
 	if (gfx_minFrameMs) LimitFPS();
 }
 
@@ -167,5 +167,34 @@ typedef void (*ScheduledTaskCallback)(struct ScheduledTask* task);
 /* Adds a task to list of scheduled tasks. (always at end) */
 CC_API int ScheduledTask_Add(double interval, ScheduledTaskCallback callback);
 
+
+/* Stages of a frame that the frame profiler attributes time to */
+enum PROFILER_STAGE {
+	PROFILER_INPUT, PROFILER_SERVER, PROFILER_ENTITIES, PROFILER_TICKS, PROFILER_CHUNKS,
+	PROFILER_WORLD, PROFILER_GUI,    PROFILER_PRESENT,  PROFILER_IDLE,  PROFILER_STAGES
+};
+/* Number of most recent frames that per-stage times are kept for */
+#define PROFILER_FRAMES 128
+
+CC_VAR extern struct _ProfilerData {
+	/* Whether frame times are currently being recorded */
+	cc_bool Enabled;
+	/* Index into Times of the frame currently being recorded */
+	int Frame;
+	/* Time (in microseconds) spent in each stage, for each of the last PROFILER_FRAMES frames */
+	int Times[PROFILER_FRAMES][PROFILER_STAGES];
+} Profiler;
+extern const char* const Profiler_Names[PROFILER_STAGES];
+
+/* Starts or stops recording frame times */
+void Profiler_SetEnabled(cc_bool enabled);
+/* Ends the current stage, then starts timing the given stage */
+CC_NOINLINE void Profiler_Switch(int stage);
+/* Calls Profiler_Switch when the profiler is enabled */
+#define Profiler_Mark(stage) do { if (Profiler.Enabled) Profiler_Switch(stage); } while (0)
+/* Writes the recently recorded stages to the given file, in Chrome's trace event JSON format */
+/* NOTE: The trace can be viewed using chrome://tracing or ui.perfetto.dev */
+cc_result Profiler_WriteTrace(const cc_string* path);
+
 CC_END_HEADER
 #endif
@@ -164,20 +164,20 @@ static void ImprovedNoise_Init(cc_uint8* p, RNGState* rnd) {
 #define Y_FLAGS 0x2222550A
 #define Grad(hash, x, y) (((X_FLAGS >> (hash)) & 3) - 1) * (x) + (((Y_FLAGS >> (hash)) & 3) - 1) * (y);
 
-static float ImprovedNoise_Calc(const cc_uint8* p, float x, float y) {
-	int xFloor, yFloor, X, Y;
-	float u, v;
+/* Calculates noise at the given x, where y has already been split into its */
+/*  lattice cell (Y), offset within that cell (y), and faded offset (v) */
+static CC_INLINE float ImprovedNoise_CalcX(const cc_uint8* p, float x, int Y, float y, float v) {
+	int xFloor, X;
+	float u;
 	int A, B, hash;
 	float g22, g12, c1;
 	float g21, g11, c2;
 
 	xFloor = x >= 0 ? (int)x : (int)x - 1;
-	yFloor = y >= 0 ? (int)y : (int)y - 1;
-	X = xFloor & 0xFF; Y = yFloor & 0xFF;
-	x -= xFloor;       y -= yFloor;
+	X = xFloor & 0xFF;
+	x -= xFloor;
 
 	u = x * x * x * (x * (x * 6 - 15) + 10); /* Fade(x) */
-	v = y * y * y * (y * (y * 6 - 15) + 10); /* Fade(y) */
 	A = p[X] + Y; B = p[X + 1] + Y;
 
 	hash = (p[p[A]] & 0xF) << 1;
@@ -195,6 +195,41 @@ static float ImprovedNoise_Calc(const cc_uint8* p, float x, float y) {
 	return c1 + v * (c2 - c1);
 }
 
+static float ImprovedNoise_Calc(const cc_uint8* p, float x, float y) {
+	int yFloor, Y;
+	float v;
+
+	yFloor = y >= 0 ? (int)y : (int)y - 1;
+	Y = yFloor & 0xFF;
+	y -= yFloor;
+	v = y * y * y * (y * (y * 6 - 15) + 10); /* Fade(y) */
+
+	return ImprovedNoise_CalcX(p, x, Y, y, v);
+}
+
+
+/* Maximum number of points that can be calculated in one call to the row functions below */
+#define NOISE_ROW_MAX 64
+
+/* Calculates noise for a row of points sharing the same y, and adds it multiplied by amplitude to sums */
+/* Produces exactly the same results as calling ImprovedNoise_Calc for each point, but the y related */
+/*  calculations are only done once per row, and the permutation table stays hot in the cache */
+static void ImprovedNoise_AddRow(const cc_uint8* p, const float* xs, float y, float freq, 
+								float amplitude, float* sums, int count) {
+	int yFloor, Y, i;
+	float v;
+
+	y *= freq;
+	yFloor = y >= 0 ? (int)y : (int)y - 1;
+	Y = yFloor & 0xFF;
+	y -= yFloor;
+	v = y * y * y * (y * (y * 6 - 15) + 10); /* Fade(y) */
+
+	for (i = 0; i < count; i++) {
+		sums[i] += ImprovedNoise_CalcX(p, xs[i] * freq, Y, y, v) * amplitude;
+	}
+}
+
 
 struct OctaveNoise { cc_uint8 p[8][NOISE_TABLE_SIZE]; int octaves; };
 static void OctaveNoise_Init(struct OctaveNoise* n, RNGState* rnd, int octaves) {
@@ -220,15 +255,38 @@ static float OctaveNoise_Calc(const struct OctaveNoise* n, float x, float y) {
 }
 
 
+/* Calculates octave noise for a row of points sharing the same y */
+/* NOTE: count must be <= NOISE_ROW_MAX */
+static void OctaveNoise_CalcRow(const struct OctaveNoise* n, const float* xs, float y, float* sums, int count) {
+	float amplitude = 1, freq = 1;
+	int i;
+
+	for (i = 0; i < count; i++) { sums[i] = 0; }
+
+	for (i = 0; i < n->octaves; i++) {
+		ImprovedNoise_AddRow(n->p[i], xs, y, freq, amplitude, sums, count);
+		amplitude *= 2.0f;
+		freq *= 0.5f;
+	}
+}
+
+
 struct CombinedNoise { struct OctaveNoise noise1, noise2; };
 static void CombinedNoise_Init(struct CombinedNoise* n, RNGState* rnd, int octaves1, int octaves2) {
 	OctaveNoise_Init(&n->noise1, rnd, octaves1);
 	OctaveNoise_Init(&n->noise2, rnd, octaves2);
 }
 
-static float CombinedNoise_Calc(const struct CombinedNoise* n, float x, float y) {
-	float offset = OctaveNoise_Calc(&n->noise2, x, y);
-	return OctaveNoise_Calc(&n->noise1, x + offset, y);
+
+/* Calculates combined noise for a row of points sharing the same y */
+/* NOTE: count must be <= NOISE_ROW_MAX */
+static void CombinedNoise_CalcRow(const struct CombinedNoise* n, const float* xs, float y, float* values, int count) {
+	float offsetXs[NOISE_ROW_MAX];
+	int i;
+
+	OctaveNoise_CalcRow(&n->noise2, xs, y, offsetXs, count);
+	for (i = 0; i < count; i++) { offsetXs[i] += xs[i]; }
+	OctaveNoise_CalcRow(&n->noise1, offsetXs, y, values, count);
 }
 
 
@@ -271,90 +329,177 @@ static void NotchyGen_FillOblateSpheroid(int x, int y, int z, float radius, Bloc
 	#define STACK_FAST 8192
 #endif
 
+/* Scanline flood fill: each popped seed is expanded into a whole run of air along the X axis, */
+/*  which is filled at once. Runs of air in the rows next to it (Z - 1, Z + 1 and Y - 1) are then */
+/*  pushed as new seeds, so the stack only ever holds one entry per run instead of per block. */
+struct FloodFillStack { int* entries; int count, limit; };
+
+static void FloodFill_PushRuns(struct FloodFillStack* stack, int rowIndex, int x1, int x2) {
+	cc_bool inRun = false;
+	int x;
+
+	for (x = x1; x <= x2; x++) {
+		if (Gen_Blocks[rowIndex + x] != BLOCK_AIR) { inRun = false; continue; }
+		if (inRun) continue;
+		inRun = true;
+
+		/* need to increase stack */
+		if (stack->count == stack->limit) {
+			Utils_Resize((void**)&stack->entries, &stack->limit, 4, STACK_FAST, STACK_FAST);
+		}
+		stack->entries[stack->count++] = rowIndex + x;
+	}
+}
+
 static void NotchyGen_FloodFill(int index, BlockRaw block) {
-	int* stack;
 	int stack_default[STACK_FAST]; /* avoid allocating memory if possible */
-	int count = 0, limit = STACK_FAST;
-	int x, y, z;
+	struct FloodFillStack stack;
+	int x, y, z, x1, x2, rowIndex;
 
-	stack = stack_default;
 	if (index < 0) return; /* y below map, don't bother starting */
-	stack[count++] = index;
-
-	while (count) {
-		index = stack[--count];
+	stack.entries = stack_default;
+	stack.limit   = STACK_FAST;
+	stack.count   = 0;
+	stack.entries[stack.count++] = index;
 
+	while (stack.count) {
+		index = stack.entries[--stack.count];
 		if (Gen_Blocks[index] != BLOCK_AIR) continue;
-		Gen_Blocks[index] = block;
 
-		x = index  % World.Width;
-		y = index  / World.OneY;
+		x = index % World.Width;
+		y = index / World.OneY;
 		z = (index / World.Width) % World.Length;
+		rowIndex = index - x;
 
-		/* need to increase stack */
-		if (count >= limit - FACE_COUNT) {
-			Utils_Resize((void**)&stack, &limit, 4, STACK_FAST, STACK_FAST);
-		}
+		/* Find extent of the run of air containing this block */
+		for (x1 = x; x1 > 0          && Gen_Blocks[rowIndex + x1 - 1] == BLOCK_AIR; x1--) { }
+		for (x2 = x; x2 < World.MaxX && Gen_Blocks[rowIndex + x2 + 1] == BLOCK_AIR; x2++) { }
+		Mem_Set(Gen_Blocks + rowIndex + x1, block, x2 - x1 + 1);
 
-		if (x > 0)          { stack[count++] = index - 1; }
-		if (x < World.MaxX) { stack[count++] = index + 1; }
-		if (z > 0)          { stack[count++] = index - World.Width; }
-		if (z < World.MaxZ) { stack[count++] = index + World.Width; }
-		if (y > 0)          { stack[count++] = index - World.OneY; }
+		if (z > 0)          FloodFill_PushRuns(&stack, rowIndex - World.Width, x1, x2);
+		if (z < World.MaxZ) FloodFill_PushRuns(&stack, rowIndex + World.Width, x1, x2);
+		if (y > 0)          FloodFill_PushRuns(&stack, rowIndex - World.OneY,  x1, x2);
 	}
-	if (limit > STACK_FAST) Mem_Free(stack);
+	if (stack.limit > STACK_FAST) Mem_Free(stack.entries);
 }
 
 
-static void NotchyGen_CreateHeightmap(void) {
+/* Noise-heavy stages are generated in bands of rows (along Z axis) on the worker pool. */
+/* Every column only depends on the read-only noise tables and its own coordinates, */
+/*  so the output is identical regardless of which order the bands are generated in. */
+#define GEN_BAND_ROWS 16
+
+#ifdef CC_BUILD_BENCH
+cc_bool Gen_SerialBands;
+#endif
+static WorkerPool_Job band_job;
+static void* band_mutex; /* Protects band_done and progress */
+static int band_done, band_count;
+
+/* Runs the given band, then updates progress based on how many bands have been completed */
+static void NotchyGen_BandJob(int job, void* obj) {
+	band_job(job, obj);
+
+	Mutex_Lock(band_mutex);
+	band_done++;
+	Gen_CurrentProgress = (float)band_done / band_count;
+	Mutex_Unlock(band_mutex);
+}
+
+static void NotchyGen_RunBands(WorkerPool_Job job, void* obj) {
+	band_job   = job;
+	band_done  = 0;
+	band_count = (World.Length + GEN_BAND_ROWS - 1) / GEN_BAND_ROWS;
+	Gen_CurrentProgress = 0.0f;
+
+#ifdef CC_BUILD_BENCH
+	if (Gen_SerialBands) {
+		int i;
+		for (i = 0; i < band_count; i++) job(i, obj);
+		return;
+	}
+#endif
+
+	band_mutex = Mutex_Create("Gen bands");
+	WorkerPool_Run(NotchyGen_BandJob, obj, band_count);
+	Mutex_Free(band_mutex);
+}
+
+#define NotchyGen_BeginBand(job, zBeg, zEnd) \
+	zBeg = (job) * GEN_BAND_ROWS; \
+	zEnd = min(zBeg + GEN_BAND_ROWS, World.Length);
+
+struct HeightmapNoise { struct CombinedNoise n1, n2; struct OctaveNoise n3; };
+
+static void NotchyGen_HeightmapBand(int job, void* obj) {
+	struct HeightmapNoise* noise = (struct HeightmapNoise*)obj;
+	float xs[NOISE_ROW_MAX], highXs[NOISE_ROW_MAX];
+	float lows[NOISE_ROW_MAX], highs[NOISE_ROW_MAX], selects[NOISE_ROW_MAX];
+	cc_uint8 highIndices[NOISE_ROW_MAX];
 	float hLow, hHigh, height;
-	int hIndex = 0, adjHeight;
+	int hIndex, zBeg, zEnd;
+	int i, j, count, highCount;
 	int x, z;
 
-#if CC_BUILD_MAXSTACK <= (16 * 1024)
-	struct NoiseBuffer { 
-		struct CombinedNoise n1, n2;
-		struct OctaveNoise n3;
-	};
-	void* mem = TempMem_Alloc(sizeof(struct NoiseBuffer));
-
-	struct NoiseBuffer* buf  = (struct NoiseBuffer*)mem;
-	struct CombinedNoise* n1 = &buf->n1;
-	struct CombinedNoise* n2 = &buf->n2;
-	struct OctaveNoise*   n3 = &buf->n3;
-#else
-	struct CombinedNoise _n1, *n1 = &_n1;
-	struct CombinedNoise _n2, *n2 = &_n2;
-	struct OctaveNoise   _n3, *n3 = &_n3;
-#endif
+	NotchyGen_BeginBand(job, zBeg, zEnd);
+	hIndex = zBeg * World.Width;
 
-	CombinedNoise_Init(n1, &rnd, 8, 8);
-	CombinedNoise_Init(n2, &rnd, 8, 8);	
-	OctaveNoise_Init(n3,   &rnd, 6);
+	for (z = zBeg; z < zEnd; z++) {
+		for (x = 0; x < World.Width; x += NOISE_ROW_MAX) {
+			count = min(World.Width - x, NOISE_ROW_MAX);
 
-	Gen_CurrentState = "Building heightmap";
-	for (z = 0; z < World.Length; z++) {
-		Gen_CurrentProgress = (float)z / World.Length;
+			for (i = 0; i < count; i++) { xs[i] = (x + i) * 1.3f; }
+			CombinedNoise_CalcRow(&noise->n1, xs, z * 1.3f, lows, count);
 
-		for (x = 0; x < World.Width; x++) {
-			hLow   = CombinedNoise_Calc(n1, x * 1.3f, z * 1.3f) / 6 - 4;
-			height = hLow;
+			for (i = 0; i < count; i++) { xs[i] = (float)(x + i); }
+			OctaveNoise_CalcRow(&noise->n3, xs, (float)z, selects, count);
 
-			if (OctaveNoise_Calc(n3, (float)x, (float)z) <= 0) {
-				hHigh = CombinedNoise_Calc(n2, x * 1.3f, z * 1.3f) / 5 + 6;
-				height = max(hLow, hHigh);
+			/* High noise is only needed for some of the columns */
+			for (i = 0, highCount = 0; i < count; i++) {
+				if (selects[i] > 0) continue;
+				highIndices[highCount] = i;
+				highXs[highCount++]    = (x + i) * 1.3f;
 			}
+			CombinedNoise_CalcRow(&noise->n2, highXs, z * 1.3f, highs, highCount);
 
-			height *= 0.5f;
-			if (height < 0) height *= 0.8f;
+			for (i = 0, j = 0; i < count; i++) {
+				hLow   = lows[i] / 6 - 4;
+				height = hLow;
 
-			adjHeight = (int)(height + waterLevel);
-			minHeight = min(adjHeight, minHeight);
-			heightmap[hIndex++] = adjHeight;
+				if (j < highCount && highIndices[j] == i) {
+					hHigh  = highs[j++] / 5 + 6;
+					height = max(hLow, hHigh);
+				}
+
+				height *= 0.5f;
+				if (height < 0) height *= 0.8f;
+				heightmap[hIndex++] = (int)(height + waterLevel);
+			}
 		}
 	}
 }
 
+static void NotchyGen_CreateHeightmap(void) {
+	int i, count = World.Width * World.Length;
+#if CC_BUILD_MAXSTACK <= (16 * 1024)
+	void* mem = TempMem_Alloc(sizeof(struct HeightmapNoise));
+	struct HeightmapNoise* noise = (struct HeightmapNoise*)mem;
+#else
+	struct HeightmapNoise _noise, *noise = &_noise;
+#endif
+
+	CombinedNoise_Init(&noise->n1, &rnd, 8, 8);
+	CombinedNoise_Init(&noise->n2, &rnd, 8, 8);	
+	OctaveNoise_Init(&noise->n3,   &rnd, 6);
+
+	Gen_CurrentState = "Building heightmap";
+	NotchyGen_RunBands(NotchyGen_HeightmapBand, noise);
+
+	for (i = 0; i < count; i++) {
+		minHeight = min(heightmap[i], minHeight);
+	}
+}
+
 static int NotchyGen_CreateStrataFast(void) {
 	cc_uint32 oneY = (cc_uint32)World.OneY;
 	int stoneHeight, airHeight;
@@ -384,23 +529,31 @@ static int NotchyGen_CreateStrataFast(void) {
 	return max(stoneHeight, 1);
 }
 
-static void NotchyGen_CreateStrata(void) {
-	int dirtThickness, dirtHeight;
-	int minStoneY, stoneHeight;
-	int hIndex = 0, maxY = World.MaxY, index = 0;
-	int x, y, z;
-	struct OctaveNoise n;
+struct StrataNoise { struct OctaveNoise n; int minStoneY; };
 
-	/* Try to bulk fill bottom of the map if possible */
-	minStoneY = NotchyGen_CreateStrataFast();
-	OctaveNoise_Init(&n, &rnd, 8);
+static void NotchyGen_StrataBand(int job, void* obj) {
+	struct StrataNoise* noise = (struct StrataNoise*)obj;
+	int dirtThickness, dirtHeight;
+	int minStoneY = noise->minStoneY, stoneHeight;
+	int hIndex, maxY = World.MaxY, index = 0;
+	float xs[NOISE_ROW_MAX], values[NOISE_ROW_MAX];
+	int x, y, z, zBeg, zEnd, i, count;
 
-	Gen_CurrentState = "Creating strata";
-	for (z = 0; z < World.Length; z++) {
-		Gen_CurrentProgress = (float)z / World.Length;
+	NotchyGen_BeginBand(job, zBeg, zEnd);
+	hIndex = zBeg * World.Width;
 
+	for (z = zBeg; z < zEnd; z++) {
 		for (x = 0; x < World.Width; x++) {
-			dirtThickness = (int)(OctaveNoise_Calc(&n, (float)x, (float)z) / 24 - 4);
+			/* Calculate noise for the next row of columns */
+			i = x % NOISE_ROW_MAX;
+			if (!i) {
+				count = min(World.Width - x, NOISE_ROW_MAX);
+				for (i = 0; i < count; i++) { xs[i] = (float)(x + i); }
+				OctaveNoise_CalcRow(&noise->n, xs, (float)z, values, count);
+				i = 0;
+			}
+
+			dirtThickness = (int)(values[i] / 24 - 4);
 			dirtHeight    = heightmap[hIndex++];
 			stoneHeight   = dirtHeight + dirtThickness;
 
@@ -421,6 +574,17 @@ static void NotchyGen_CreateStrata(void) {
 	}
 }
 
+static void NotchyGen_CreateStrata(void) {
+	struct StrataNoise noise;
+
+	/* Try to bulk fill bottom of the map if possible */
+	noise.minStoneY = NotchyGen_CreateStrataFast();
+	OctaveNoise_Init(&noise.n, &rnd, 8);
+
+	Gen_CurrentState = "Creating strata";
+	NotchyGen_RunBands(NotchyGen_StrataBand, &noise);
+}
+
 static void NotchyGen_CarveCaves(void) {
 	int cavesCount, caveLen;
 	float caveX, caveY, caveZ;
@@ -561,30 +725,18 @@ static void NotchyGen_FloodFillLava(void) {
 	}
 }
 
-static void NotchyGen_CreateSurfaceLayer(void) {	
-	int hIndex = 0, index;
-	BlockRaw above;
-	int x, y, z;
-#if CC_BUILD_MAXSTACK <= (16 * 1024)
-	struct NoiseBuffer { 
-		struct OctaveNoise n1, n2;
-	};
-	struct NoiseBuffer* buf = TempMem_Alloc(sizeof(struct NoiseBuffer));
-	struct OctaveNoise* n1 = &buf->n1;
-	struct OctaveNoise* n2 = &buf->n2;
-#else
-	struct OctaveNoise _n1, _n2;
-	struct OctaveNoise* n1 = &_n1;
-	struct OctaveNoise* n2 = &_n2;
-#endif
+struct SurfaceNoise { struct OctaveNoise n1, n2; };
 
-	OctaveNoise_Init(n1, &rnd, 8);
-	OctaveNoise_Init(n2, &rnd, 8);
+static void NotchyGen_SurfaceBand(int job, void* obj) {
+	struct SurfaceNoise* noise = (struct SurfaceNoise*)obj;
+	int hIndex, index;
+	BlockRaw above;
+	int x, y, z, zBeg, zEnd;
 
-	Gen_CurrentState = "Creating surface";
-	for (z = 0; z < World.Length; z++) {
-		Gen_CurrentProgress = (float)z / World.Length;
+	NotchyGen_BeginBand(job, zBeg, zEnd);
+	hIndex = zBeg * World.Width;
 
+	for (z = zBeg; z < zEnd; z++) {
 		for (x = 0; x < World.Width; x++) {
 			y = heightmap[hIndex++];
 			if (y < 0 || y >= World.Height) continue;
@@ -593,15 +745,29 @@ static void NotchyGen_CreateSurfaceLayer(void) {
 			above = y >= World.MaxY ? BLOCK_AIR : Gen_Blocks[index + World.OneY];
 
 			/* TODO: update heightmap */
-			if (above == BLOCK_STILL_WATER && (OctaveNoise_Calc(n2, (float)x, (float)z) > 12)) {
+			if (above == BLOCK_STILL_WATER && (OctaveNoise_Calc(&noise->n2, (float)x, (float)z) > 12)) {
 				Gen_Blocks[index] = BLOCK_GRAVEL;
 			} else if (above == BLOCK_AIR) {
-				Gen_Blocks[index] = (y <= waterLevel && (OctaveNoise_Calc(n1, (float)x, (float)z) > 8)) ? BLOCK_SAND : BLOCK_GRASS;
+				Gen_Blocks[index] = (y <= waterLevel && (OctaveNoise_Calc(&noise->n1, (float)x, (float)z) > 8)) ? BLOCK_SAND : BLOCK_GRASS;
 			}
 		}
 	}
 }
 
+static void NotchyGen_CreateSurfaceLayer(void) {
+#if CC_BUILD_MAXSTACK <= (16 * 1024)
+	struct SurfaceNoise* noise = TempMem_Alloc(sizeof(struct SurfaceNoise));
+#else
+	struct SurfaceNoise _noise, *noise = &_noise;
+#endif
+
+	OctaveNoise_Init(&noise->n1, &rnd, 8);
+	OctaveNoise_Init(&noise->n2, &rnd, 8);
+
+	Gen_CurrentState = "Creating surface";
+	NotchyGen_RunBands(NotchyGen_SurfaceBand, noise);
+}
+
 static void NotchyGen_PlantFlowers(void) {
 	int numPatches;
 	BlockRaw block;
@@ -730,6 +896,8 @@ static cc_bool NotchyGen_Prepare(void) {
 	minHeight  = World.Height;
 
 	heightmap  = (cc_int16*)Mem_TryAlloc(World.Width * World.Length, 2);
+	/* Generating happens on a separate thread, so worker pool must be started here */
+	WorkerPool_Init();
 	return heightmap != NULL;
 }
 
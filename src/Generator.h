@@ -31,6 +31,10 @@ struct MapGenerator {
 extern const struct MapGenerator* Gen_Active;
 extern const struct MapGenerator FlatgrassGen;
 extern const struct MapGenerator NotchyGen;
+#ifdef CC_BUILD_BENCH
+/* Whether noise bands are generated serially on the generating thread, instead of on the worker pool */
+extern cc_bool Gen_SerialBands;
+#endif
 
 
 extern BlockRaw* Tree_Blocks;
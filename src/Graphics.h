@@ -27,12 +27,18 @@ struct IGameComponent;
 struct MenuOptionsScreen;
 extern struct IGameComponent Gfx_Component;
 
+#if CC_GFX_BACKEND == CC_GFX_BACKEND_GL2
+/* Chunk meshes are stored using the compact VertexChunk format */
+#define CC_BUILD_COMPACTCHUNKS
+#endif
+
 typedef enum VertexFormat_ {
-	VERTEX_FORMAT_COLOURED, VERTEX_FORMAT_TEXTURED
+	VERTEX_FORMAT_COLOURED, VERTEX_FORMAT_TEXTURED, VERTEX_FORMAT_CHUNK
 } VertexFormat;
 
 #define SIZEOF_VERTEX_COLOURED 16
 #define SIZEOF_VERTEX_TEXTURED 24
+#define SIZEOF_VERTEX_CHUNK    16
 
 #if defined CC_BUILD_PSP
 /* 3 floats for position (XYZ), 4 bytes for colour */
@@ -46,6 +52,16 @@ struct VertexColoured { float x, y, z; PackedCol Col; };
 struct VertexTextured { float x, y, z; PackedCol Col; float U, V; };
 #endif
 
+/* Fractional units per block of VertexChunk positions */
+#define CHUNKVERT_POS_SCALE 256
+/* Fractional units per texture of VertexChunk U coordinates (U repeats across stretched faces) */
+#define CHUNKVERT_U_SCALE 2048
+/* Fractional units per atlas of VertexChunk V coordinates */
+#define CHUNKVERT_V_SCALE 65536
+/* 3 shorts for position relative to chunk origin (XYZ), 4 bytes for colour, 2 shorts for texture coordinates (UV) */
+/* NOTE: Only used for chunk meshes when CC_BUILD_COMPACTCHUNKS is defined */
+struct VertexChunk { cc_int16 x, y, z, w; PackedCol Col; cc_uint16 U, V; };
+
 void Gfx_Create(void);
 void Gfx_Free(void);
 
@@ -378,6 +394,10 @@ CC_API void Gfx_DrawVb_IndexedTris_Range(int verticesCount, int startVertex, Dra
 CC_API void Gfx_DrawVb_IndexedTris(int verticesCount);
 /* Special case Gfx_DrawVb_IndexedTris_Range for map renderer */
 void Gfx_DrawIndexedTris_T2fC4b(int verticesCount, int startVertex);
+#ifdef CC_BUILD_COMPACTCHUNKS
+/* Sets the world coordinates that positions of VERTEX_FORMAT_CHUNK vertices are relative to */
+void Gfx_SetChunkOrigin(int x, int y, int z);
+#endif
 
 
 /*########################################################################################################################*
@@ -71,9 +71,7 @@ static const struct DynamicLibSym coreFuncs[] = {
 	#include "../misc/opengl/GL1Macros.h"
 #endif
 
-typedef void (*GL_SetupVBFunc)(void);
 typedef void (*GL_SetupVBRangeFunc)(int startVertex);
-static GL_SetupVBFunc gfx_setupVBFunc;
 static GL_SetupVBRangeFunc gfx_setupVBRangeFunc;
 
 #include "_GLShared.h"
@@ -134,6 +132,7 @@ static GfxResourceID Gfx_AllocStaticVb(VertexFormat fmt, int count) {
 
 void Gfx_BindVb(GfxResourceID vb) { 
 	_glBindBuffer(GL_ARRAY_BUFFER, vb); 
+	gfx_baseVertex = 0;
 }
 
 void Gfx_DeleteVb(GfxResourceID* vb) {
@@ -155,22 +154,27 @@ void Gfx_UnlockVb(GfxResourceID vb) {
 *--------------------------------------------------Dynamic vertex buffers-------------------------------------------------*
 *#########################################################################################################################*/
 static GfxResourceID Gfx_AllocDynamicVb(VertexFormat fmt, int maxVertices) {
-	GfxResourceID id = NULL;
-	cc_uint32 size   = maxVertices * strideSizes[fmt];
+	struct GLDynamicVb* vb = GLDynamicVb_Alloc(fmt, maxVertices);
+	if (!vb) return NULL;
 
-	_glGenBuffers(1, (GLuint*)&id);
-	_glBindBuffer(GL_ARRAY_BUFFER, id);
-	_glBufferData(GL_ARRAY_BUFFER, size, NULL, GL_DYNAMIC_DRAW);
-	return id;
+	_glGenBuffers(1, (GLuint*)&vb->id);
+	_glBindBuffer(GL_ARRAY_BUFFER, vb->id);
+	_glBufferData(GL_ARRAY_BUFFER, vb->size, NULL, GL_DYNAMIC_DRAW);
+	return vb;
 }
 
 void Gfx_BindDynamicVb(GfxResourceID vb) {
-	_glBindBuffer(GL_ARRAY_BUFFER, vb); 
+	struct GLDynamicVb* dyn = (struct GLDynamicVb*)vb;
+	_glBindBuffer(GL_ARRAY_BUFFER, dyn->id); 
+	gfx_baseVertex = dyn->base;
 }
 
 void Gfx_DeleteDynamicVb(GfxResourceID* vb) {
-	GfxResourceID id = *vb;
-	if (id) _glDeleteBuffers(1, (GLuint*)&id);
+	struct GLDynamicVb* dyn = (struct GLDynamicVb*)(*vb);
+	if (!dyn) return;
+
+	if (dyn->id) _glDeleteBuffers(1, (GLuint*)&dyn->id);
+	Mem_Free(dyn);
 	*vb = 0;
 }
 
@@ -178,15 +182,20 @@ void* Gfx_LockDynamicVb(GfxResourceID vb, VertexFormat fmt, int count) {
 	return FastAllocTempMem(count * strideSizes[fmt]);
 }
 
+static void UploadDynamicVb(struct GLDynamicVb* vb, void* data, cc_uint32 size) {
+	cc_uint32 offset = GLDynamicVb_Reserve(vb, size);
+	_glBindBuffer(GL_ARRAY_BUFFER, vb->id);
+
+	if (!offset) _glBufferData(GL_ARRAY_BUFFER, vb->size, NULL, GL_DYNAMIC_DRAW);
+	_glBufferSubData(GL_ARRAY_BUFFER, offset, size, data);
+}
+
 void Gfx_UnlockDynamicVb(GfxResourceID vb) {
-	_glBindBuffer(GL_ARRAY_BUFFER, vb);
-	_glBufferSubData(GL_ARRAY_BUFFER, 0, tmpSize, tmpData);
+	UploadDynamicVb((struct GLDynamicVb*)vb, tmpData, tmpSize);
 }
 
 void Gfx_SetDynamicVbData(GfxResourceID vb, void* vertices, int vCount) {
-	cc_uint32 size = vCount * gfx_stride;
-	_glBindBuffer(GL_ARRAY_BUFFER, vb);
-	_glBufferSubData(GL_ARRAY_BUFFER, 0, size, vertices);
+	UploadDynamicVb((struct GLDynamicVb*)vb, vertices, vCount * gfx_stride);
 }
 
 
@@ -197,17 +206,6 @@ void Gfx_SetDynamicVbData(GfxResourceID vb, void* vertices, int vCount) {
 #define VB_PTR 0
 #define IB_PTR NULL
 
-static void GL_SetupVbColoured(void) {
-	_glVertexPointer(3, GL_FLOAT,        SIZEOF_VERTEX_COLOURED, VB_PTR +  0);
-	_glColorPointer(4, GL_UNSIGNED_BYTE, SIZEOF_VERTEX_COLOURED, VB_PTR + 12);
-}
-
-static void GL_SetupVbTextured(void) {
-	_glVertexPointer(3, GL_FLOAT,        SIZEOF_VERTEX_TEXTURED, VB_PTR +  0);
-	_glColorPointer(4, GL_UNSIGNED_BYTE, SIZEOF_VERTEX_TEXTURED, VB_PTR + 12);
-	_glTexCoordPointer(2, GL_FLOAT,      SIZEOF_VERTEX_TEXTURED, VB_PTR + 16);
-}
-
 static void GL_SetupVbColoured_Range(int startVertex) {
 	cc_uint32 offset = startVertex * SIZEOF_VERTEX_COLOURED;
 	_glVertexPointer(3, GL_FLOAT,          SIZEOF_VERTEX_COLOURED, VB_PTR + offset +  0);
@@ -230,29 +228,27 @@ void Gfx_SetVertexFormat(VertexFormat fmt) {
 		_glEnableClientState(GL_TEXTURE_COORD_ARRAY);
 		_glEnable(GL_TEXTURE_2D);
 
-		gfx_setupVBFunc      = GL_SetupVbTextured;
 		gfx_setupVBRangeFunc = GL_SetupVbTextured_Range;
 	} else {
 		_glDisableClientState(GL_TEXTURE_COORD_ARRAY);
 		_glDisable(GL_TEXTURE_2D);
 
-		gfx_setupVBFunc      = GL_SetupVbColoured;
 		gfx_setupVBRangeFunc = GL_SetupVbColoured_Range;
 	}
 }
 
 void Gfx_DrawVb_Lines(int verticesCount) {
-	gfx_setupVBFunc();
+	gfx_setupVBRangeFunc(gfx_baseVertex);
 	_glDrawArrays(GL_LINES, 0, verticesCount);
 }
 
 void Gfx_DrawVb_IndexedTris_Range(int verticesCount, int startVertex, DrawHints hints) {
-	gfx_setupVBRangeFunc(startVertex);
+	gfx_setupVBRangeFunc(gfx_baseVertex + startVertex);
 	_glDrawElements(GL_TRIANGLES, ICOUNT(verticesCount), GL_UNSIGNED_SHORT, IB_PTR);
 }
 
 void Gfx_DrawVb_IndexedTris(int verticesCount) {
-	gfx_setupVBFunc();
+	gfx_setupVBRangeFunc(gfx_baseVertex);
 	_glDrawElements(GL_TRIANGLES, ICOUNT(verticesCount), GL_UNSIGNED_SHORT, IB_PTR);
 }
 
@@ -471,7 +467,7 @@ static void APIENTRY legacy_bufferData(GLenum target, cc_uintptr size, const GLv
 
 static void APIENTRY legacy_bufferSubData(GLenum target, cc_uintptr offset, cc_uintptr size, const GLvoid* data) {
 	legacy_buffer* buffer = *legacy_GetBuffer(target);
-	Mem_Copy(buffer->data, data, size);
+	Mem_Copy(buffer->data + offset, data, size);
 }
 
 
@@ -106,6 +106,7 @@ static GfxResourceID Gfx_AllocStaticVb(VertexFormat fmt, int count) {
 
 void Gfx_BindVb(GfxResourceID vb) { 
 	glBindBuffer(GL_ARRAY_BUFFER, ptr_to_uint(vb)); 
+	gfx_baseVertex = 0;
 }
 
 void Gfx_DeleteVb(GfxResourceID* vb) {
@@ -127,20 +128,28 @@ void Gfx_UnlockVb(GfxResourceID vb) {
 *--------------------------------------------------Dynamic vertex buffers-------------------------------------------------*
 *#########################################################################################################################*/
 static GfxResourceID Gfx_AllocDynamicVb(VertexFormat fmt, int maxVertices) {
-	GLuint id      = GL_GenAndBind(GL_ARRAY_BUFFER);
-	cc_uint32 size = maxVertices * strideSizes[fmt];
+	struct GLDynamicVb* vb = GLDynamicVb_Alloc(fmt, maxVertices);
+	if (!vb) return NULL;
 
-	glBufferData(GL_ARRAY_BUFFER, size, NULL, GL_DYNAMIC_DRAW);
-	return uint_to_ptr(id);
+	vb->id = uint_to_ptr(GL_GenAndBind(GL_ARRAY_BUFFER));
+	glBufferData(GL_ARRAY_BUFFER, vb->size, NULL, GL_DYNAMIC_DRAW);
+	return vb;
 }
 
 void Gfx_BindDynamicVb(GfxResourceID vb) {
-	glBindBuffer(GL_ARRAY_BUFFER, ptr_to_uint(vb)); 
+	struct GLDynamicVb* dyn = (struct GLDynamicVb*)vb;
+	glBindBuffer(GL_ARRAY_BUFFER, ptr_to_uint(dyn->id));
+	gfx_baseVertex = dyn->base;
 }
 
 void Gfx_DeleteDynamicVb(GfxResourceID* vb) {
-	GLuint id = ptr_to_uint(*vb);
+	struct GLDynamicVb* dyn = (struct GLDynamicVb*)(*vb);
+	GLuint id;
+	if (!dyn) return;
+
+	id = ptr_to_uint(dyn->id);
 	if (id) glDeleteBuffers(1, &id);
+	Mem_Free(dyn);
 	*vb = 0;
 }
 
@@ -148,15 +157,20 @@ void* Gfx_LockDynamicVb(GfxResourceID vb, VertexFormat fmt, int count) {
 	return FastAllocTempMem(count * strideSizes[fmt]);
 }
 
+static void UploadDynamicVb(struct GLDynamicVb* vb, void* data, cc_uint32 size) {
+	cc_uint32 offset = GLDynamicVb_Reserve(vb, size);
+	glBindBuffer(GL_ARRAY_BUFFER, ptr_to_uint(vb->id));
+
+	if (!offset) glBufferData(GL_ARRAY_BUFFER, vb->size, NULL, GL_DYNAMIC_DRAW);
+	glBufferSubData(GL_ARRAY_BUFFER, offset, size, data);
+}
+
 void Gfx_UnlockDynamicVb(GfxResourceID vb) {
-	glBindBuffer(GL_ARRAY_BUFFER, ptr_to_uint(vb));
-	glBufferSubData(GL_ARRAY_BUFFER, 0, tmpSize, tmpData);
+	UploadDynamicVb((struct GLDynamicVb*)vb, tmpData, tmpSize);
 }
 
 void Gfx_SetDynamicVbData(GfxResourceID vb, void* vertices, int vCount) {
-	cc_uint32 size = vCount * gfx_stride;
-	glBindBuffer(GL_ARRAY_BUFFER, ptr_to_uint(vb));
-	glBufferSubData(GL_ARRAY_BUFFER, 0, size, vertices);
+	UploadDynamicVb((struct GLDynamicVb*)vb, vertices, vCount * gfx_stride);
 }
 
 
@@ -168,6 +182,7 @@ void Gfx_SetDynamicVbData(GfxResourceID vb, void* vertices, int vCount) {
 #define FTR_TEX_OFFSET (1 << 2)
 #define FTR_LINEAR_FOG (1 << 3)
 #define FTR_DENSIT_FOG (1 << 4)
+#define FTR_CHUNK_VERT (1 << 5)
 #define FTR_HASANY_FOG (FTR_LINEAR_FOG | FTR_DENSIT_FOG)
 #define FTR_FS_MEDIUMP (1 << 7)
 
@@ -176,7 +191,8 @@ void Gfx_SetDynamicVbData(GfxResourceID vb, void* vertices, int vCount) {
 #define UNI_FOG_COL    (1 << 2)
 #define UNI_FOG_END    (1 << 3)
 #define UNI_FOG_DENS   (1 << 4)
-#define UNI_MASK_ALL   0x1F
+#define UNI_CHUNK_POS  (1 << 5)
+#define UNI_MASK_ALL   0x3F
 
 /* cached uniforms (cached for multiple programs */
 static struct Matrix _view, _proj, _mvp;
@@ -185,14 +201,15 @@ static float _texX, _texY;
 static PackedCol gfx_fogColor;
 static float gfx_fogEnd = -1.0f, gfx_fogDensity = -1.0f;
 static int gfx_fogMode = -1;
+static int _chunkX, _chunkY, _chunkZ;
 
 /* shader programs (emulate fixed function) */
 static struct GLShader {
 	int features;     /* what features are enabled for this shader */
 	int uniforms;     /* which associated uniforms need to be resent to GPU */
 	GLuint program;   /* OpenGL program ID (0 if not yet compiled) */
-	int locations[5]; /* location of uniforms (not constant) */
-} shaders[6 * 3] = {
+	int locations[6]; /* location of uniforms (not constant) */
+} shaders[8 * 3] = {
 	/* no fog */
 	{ 0              },
 	{ 0              | FTR_ALPHA_TEST },
@@ -200,6 +217,8 @@ static struct GLShader {
 	{ FTR_TEXTURE_UV | FTR_ALPHA_TEST },
 	{ FTR_TEXTURE_UV | FTR_TEX_OFFSET },
 	{ FTR_TEXTURE_UV | FTR_TEX_OFFSET | FTR_ALPHA_TEST },
+	{ FTR_TEXTURE_UV | FTR_CHUNK_VERT },
+	{ FTR_TEXTURE_UV | FTR_CHUNK_VERT | FTR_ALPHA_TEST },
 	/* linear fog */
 	{ FTR_LINEAR_FOG | 0              },
 	{ FTR_LINEAR_FOG | 0              | FTR_ALPHA_TEST },
@@ -207,6 +226,8 @@ static struct GLShader {
 	{ FTR_LINEAR_FOG | FTR_TEXTURE_UV | FTR_ALPHA_TEST },
 	{ FTR_LINEAR_FOG | FTR_TEXTURE_UV | FTR_TEX_OFFSET },
 	{ FTR_LINEAR_FOG | FTR_TEXTURE_UV | FTR_TEX_OFFSET | FTR_ALPHA_TEST },
+	{ FTR_LINEAR_FOG | FTR_TEXTURE_UV | FTR_CHUNK_VERT },
+	{ FTR_LINEAR_FOG | FTR_TEXTURE_UV | FTR_CHUNK_VERT | FTR_ALPHA_TEST },
 	/* density fog */
 	{ FTR_DENSIT_FOG | 0              },
 	{ FTR_DENSIT_FOG | 0              | FTR_ALPHA_TEST },
@@ -214,6 +235,8 @@ static struct GLShader {
 	{ FTR_DENSIT_FOG | FTR_TEXTURE_UV | FTR_ALPHA_TEST },
 	{ FTR_DENSIT_FOG | FTR_TEXTURE_UV | FTR_TEX_OFFSET },
 	{ FTR_DENSIT_FOG | FTR_TEXTURE_UV | FTR_TEX_OFFSET | FTR_ALPHA_TEST },
+	{ FTR_DENSIT_FOG | FTR_TEXTURE_UV | FTR_CHUNK_VERT },
+	{ FTR_DENSIT_FOG | FTR_TEXTURE_UV | FTR_CHUNK_VERT | FTR_ALPHA_TEST },
 };
 static struct GLShader* gfx_activeShader;
 
@@ -221,6 +244,7 @@ static struct GLShader* gfx_activeShader;
 static void GenVertexShader(const struct GLShader* shader, cc_string* dst) {
 	int uv = shader->features & FTR_TEXTURE_UV;
 	int tm = shader->features & FTR_TEX_OFFSET;
+	int cv = shader->features & FTR_CHUNK_VERT;
 
 	String_AppendConst(dst,         "attribute vec3 in_pos;\n");
 	String_AppendConst(dst,         "attribute vec4 in_col;\n");
@@ -229,11 +253,16 @@ static void GenVertexShader(const struct GLShader* shader, cc_string* dst) {
 	if (uv) String_AppendConst(dst, "varying vec2 out_uv;\n");
 	String_AppendConst(dst,         "uniform mat4 mvp;\n");
 	if (tm) String_AppendConst(dst, "uniform vec2 texOffset;\n");
+	if (cv) String_AppendConst(dst, "uniform vec3 chunkPos;\n");
 
 	String_AppendConst(dst,         "void main() {\n");
-	String_AppendConst(dst,         "  gl_Position = mvp * vec4(in_pos, 1.0);\n");
+	/* Compact chunk vertices store positions and texture coordinates as fixed point (see CHUNKVERT_POS_SCALE etc) */
+	if (cv) String_AppendConst(dst, "  vec3 pos = in_pos * (1.0 / 256.0) + chunkPos;\n");
+	else    String_AppendConst(dst, "  vec3 pos = in_pos;\n");
+	String_AppendConst(dst,         "  gl_Position = mvp * vec4(pos, 1.0);\n");
 	String_AppendConst(dst,         "  out_col = in_col;\n");
-	if (uv) String_AppendConst(dst, "  out_uv  = in_uv;\n");
+	if (cv) String_AppendConst(dst, "  out_uv  = in_uv * vec2(1.0 / 2048.0, 1.0 / 65536.0);\n");
+	else if (uv) String_AppendConst(dst, "  out_uv  = in_uv;\n");
 	if (tm) String_AppendConst(dst, "  out_uv  = out_uv + texOffset;\n");
 	String_AppendConst(dst,         "}");
 }
@@ -369,6 +398,7 @@ static void CompileProgram(struct GLShader* shader) {
 		shader->locations[2] = glGetUniformLocation(program, "fogCol");
 		shader->locations[3] = glGetUniformLocation(program, "fogEnd");
 		shader->locations[4] = glGetUniformLocation(program, "fogDensity");
+		shader->locations[5] = glGetUniformLocation(program, "chunkPos");
 		return;
 	}
 	temp = 0;
@@ -418,6 +448,10 @@ static void ReloadUniforms(void) {
 		glUniform1f(s->locations[4], -gfx_fogDensity);
 		s->uniforms &= ~UNI_FOG_DENS;
 	}
+	if ((s->uniforms & UNI_CHUNK_POS) && (s->features & FTR_CHUNK_VERT)) {
+		glUniform3f(s->locations[5], (float)_chunkX, (float)_chunkY, (float)_chunkZ);
+		s->uniforms &= ~UNI_CHUNK_POS;
+	}
 }
 
 /* Switches program to one that duplicates current fixed function state */
@@ -427,12 +461,16 @@ static void SwitchProgram(void) {
 	int index = 0;
 
 	if (gfx_fogEnabled) {
-		index += 6;                       /* linear fog */
-		if (gfx_fogMode >= 1) index += 6; /* exp fog */
+		index += 8;                       /* linear fog */
+		if (gfx_fogMode >= 1) index += 8; /* exp fog */
 	}
 
-	if (gfx_format == VERTEX_FORMAT_TEXTURED) index += 2;
-	if (gfx_texTransform) index += 2;
+	if (gfx_format == VERTEX_FORMAT_CHUNK) {
+		index += 6;
+	} else {
+		if (gfx_format == VERTEX_FORMAT_TEXTURED) index += 2;
+		if (gfx_texTransform) index += 2;
+	}
 	if (gfx_alphaTest)    index += 1;
 
 	shader = &shaders[index];
@@ -528,10 +566,28 @@ void Gfx_DisableTextureOffset(void) {
 	SwitchProgram();
 }
 
+void Gfx_SetChunkOrigin(int x, int y, int z) {
+	if (x == _chunkX && y == _chunkY && z == _chunkZ) return;
+	_chunkX = x; _chunkY = y; _chunkZ = z;
+
+	DirtyUniform(UNI_CHUNK_POS);
+	ReloadUniforms();
+}
+
 
 /*########################################################################################################################*
 *-------------------------------------------------------State setup-------------------------------------------------------*
 *#########################################################################################################################*/
+/* Mipmaps generated by the driver are not averaged using premultiplied alpha like GenMipmaps, */
+/*  so edges of cutout textures (e.g. leaves) may look darker. Hence they must be opted into */
+static void GLBackend_InitMipmaps(cc_bool supported) {
+	_glGenerateMipmap = NULL;
+	if (!supported || !Options_GetBool(OPT_GPU_MIPMAPS, false)) return;
+
+	*(void**)&_glGenerateMipmap = GLContext_GetAddress("glGenerateMipmap");
+	Platform_Log1("GPU mipmaps generation: %c", _glGenerateMipmap ? "supported" : "unavailable");
+}
+
 static void GLBackend_Init(void) {
 #ifdef CC_BUILD_GLES
 	// OpenGL ES 2.0 doesn't support custom mipmaps levels, but 3.2 does
@@ -555,6 +611,8 @@ static void GLBackend_Init(void) {
 	glGetIntegerv(_GL_MAJOR_VERSION, &major);
 	glGetIntegerv(_GL_MINOR_VERSION, &minor);
 	customMipmapsLevels = major >= 3 && minor >= 2;
+	/* glGenerateMipmap is part of core OpenGL ES 2.0 */
+	GLBackend_InitMipmaps(true);
 
 	Platform_Log2("BGRA support - Ext: %t, Apple: %t", &has_ext_bgra, &has_apl_bgra);
 	convert_rgba = PIXEL_FORMAT != GL_RGBA && !has_ext_bgra && !has_apl_bgra && !has_sym_bgra;
@@ -562,6 +620,7 @@ static void GLBackend_Init(void) {
     customMipmapsLevels = true;
     const GLubyte* ver  = glGetString(GL_VERSION);
     int major = ver[0] - '0', minor = ver[2] - '0';
+    GLBackend_InitMipmaps(major >= 3);
     if (major >= 2) return;
 
     // OpenGL 1.x.. will likely either not work or perform poorly
@@ -673,6 +732,12 @@ static void GL_SetupVbTextured(void) {
 	glVertexAttribPointer(2, 2, GL_FLOAT,         false, SIZEOF_VERTEX_TEXTURED, uint_to_ptr(16));
 }
 
+static void GL_SetupVbChunk(void) {
+	glVertexAttribPointer(0, 3, GL_SHORT,          false, SIZEOF_VERTEX_CHUNK, uint_to_ptr( 0));
+	glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE,  true,  SIZEOF_VERTEX_CHUNK, uint_to_ptr( 8));
+	glVertexAttribPointer(2, 2, GL_UNSIGNED_SHORT, false, SIZEOF_VERTEX_CHUNK, uint_to_ptr(12));
+}
+
 static void GL_SetupVbColoured_Range(int startVertex) {
 	cc_uint32 offset = startVertex * SIZEOF_VERTEX_COLOURED;
 	glVertexAttribPointer(0, 3, GL_FLOAT,         false, SIZEOF_VERTEX_COLOURED, uint_to_ptr(offset     ));
@@ -686,6 +751,13 @@ static void GL_SetupVbTextured_Range(int startVertex) {
 	glVertexAttribPointer(2, 2, GL_FLOAT,         false, SIZEOF_VERTEX_TEXTURED, uint_to_ptr(offset + 16));
 }
 
+static void GL_SetupVbChunk_Range(int startVertex) {
+	cc_uint32 offset = startVertex * SIZEOF_VERTEX_CHUNK;
+	glVertexAttribPointer(0, 3, GL_SHORT,          false, SIZEOF_VERTEX_CHUNK, uint_to_ptr(offset     ));
+	glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE,  true,  SIZEOF_VERTEX_CHUNK, uint_to_ptr(offset +  8));
+	glVertexAttribPointer(2, 2, GL_UNSIGNED_SHORT, false, SIZEOF_VERTEX_CHUNK, uint_to_ptr(offset + 12));
+}
+
 void Gfx_SetVertexFormat(VertexFormat fmt) {
 	if (fmt == gfx_format) return;
 	gfx_format = fmt;
@@ -695,6 +767,10 @@ void Gfx_SetVertexFormat(VertexFormat fmt) {
 		glEnableVertexAttribArray(2);
 		gfx_setupVBFunc      = GL_SetupVbTextured;
 		gfx_setupVBRangeFunc = GL_SetupVbTextured_Range;
+	} else if (fmt == VERTEX_FORMAT_CHUNK) {
+		glEnableVertexAttribArray(2);
+		gfx_setupVBFunc      = GL_SetupVbChunk;
+		gfx_setupVBRangeFunc = GL_SetupVbChunk_Range;
 	} else {
 		glDisableVertexAttribArray(2);
 		gfx_setupVBFunc      = GL_SetupVbColoured;
@@ -704,30 +780,31 @@ void Gfx_SetVertexFormat(VertexFormat fmt) {
 }
 
 void Gfx_DrawVb_Lines(int verticesCount) {
-	gfx_setupVBFunc();
+	gfx_setupVBRangeFunc(gfx_baseVertex);
 	glDrawArrays(GL_LINES, 0, verticesCount);
 }
 
 void Gfx_DrawVb_IndexedTris_Range(int verticesCount, int startVertex, DrawHints hints) {
-	gfx_setupVBRangeFunc(startVertex);
+	gfx_setupVBRangeFunc(gfx_baseVertex + startVertex);
 	glDrawElements(GL_TRIANGLES, ICOUNT(verticesCount), GL_UNSIGNED_SHORT, NULL);
 }
 
 void Gfx_DrawVb_IndexedTris(int verticesCount) {
-	gfx_setupVBFunc();
+	gfx_setupVBRangeFunc(gfx_baseVertex);
 	glDrawElements(GL_TRIANGLES, ICOUNT(verticesCount), GL_UNSIGNED_SHORT, NULL);
 }
 
+/* NOTE: Map renderer uses either VERTEX_FORMAT_TEXTURED or VERTEX_FORMAT_CHUNK */
 void Gfx_BindVb_Textured(GfxResourceID vb) {
 	Gfx_BindVb(vb);
-	GL_SetupVbTextured();
+	gfx_setupVBFunc();
 }
 
 void Gfx_DrawIndexedTris_T2fC4b(int verticesCount, int startVertex) {
 	if (startVertex + verticesCount > GFX_MAX_VERTICES) {
-		GL_SetupVbTextured_Range(startVertex);
+		gfx_setupVBRangeFunc(startVertex);
 		glDrawElements(GL_TRIANGLES, ICOUNT(verticesCount), GL_UNSIGNED_SHORT, NULL);
-		GL_SetupVbTextured();
+		gfx_setupVBFunc();
 	} else {
 		/* ICOUNT(startVertex) * 2 = startVertex * 3  */
 		glDrawElements(GL_TRIANGLES, ICOUNT(verticesCount), GL_UNSIGNED_SHORT, uint_to_ptr(startVertex * 3));
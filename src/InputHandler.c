@@ -635,7 +635,11 @@ static void BindReleased_PickBlock(int key, struct InputDevice* device) {
 static cc_bool BindTriggered_HideFPS(int key, struct InputDevice* device) {
 	if (Gui.InputGrab) return false;
 	
-	Gui.ShowFPS = !Gui.ShowFPS;
+	if (Input_IsShiftPressed()) {
+		Profiler_SetEnabled(!Profiler.Enabled);
+	} else {
+		Gui.ShowFPS = !Gui.ShowFPS;
+	}
 	return true;
 }
 
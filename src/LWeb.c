@@ -487,11 +487,28 @@ static void FetchServersTask_Next(struct JsonContext* ctx) {
 	ServerInfo_Init(curServer);
 }
 
+static void FetchServersTask_LowerNames(void) {
+	struct ServerInfo* info;
+	char c;
+	int i, j;
+
+	for (i = 0; i < FetchServersTask.numServers; i++) 
+	{
+		info = &FetchServersTask.servers[i];
+		for (j = 0; j < info->name.length; j++) 
+		{
+			c = info->name.buffer[j]; Char_MakeLower(c);
+			info->_lowerName[j] = c;
+		}
+	}
+}
+
 static void FetchServersTask_Handle(cc_uint8* data, cc_uint32 len) {
 	static cc_string err_msg = String_FromConst("Error parsing servers list response JSON");
 
 	int count;
 	cc_bool success;
+	FetchServersTask.version++;
 	Mem_Free(FetchServersTask.servers);
 	Mem_Free(FetchServersTask.orders);
 	Session_Save();
@@ -511,6 +528,7 @@ static void FetchServersTask_Handle(cc_uint8* data, cc_uint32 len) {
 
 	curServer = FetchServersTask.servers - 1;
 	Json_Handle(data, len, ServerInfo_Parse, NULL, FetchServersTask_Next);
+	FetchServersTask_LowerNames();
 }
 
 void FetchServersTask_Run(void) {
@@ -628,28 +646,15 @@ struct FetchFlagsData FetchFlagsTask;
 static int flagsCount, flagsCapacity;
 static struct Flag* flags;
 
-static void FetchFlagsTask_DownloadNext(void);
-static void FetchFlagsTask_Handle(cc_uint8* data, cc_uint32 len) {
-	struct Flag* flag = &flags[FetchFlagsTask.count];
-	LBackend_DecodeFlag(flag, data, len);
-	
-	FetchFlagsTask.count++;
-	FetchFlagsTask_DownloadNext();
-}
-
-static void FetchFlagsTask_DownloadNext(void) {
+/* All flags are requested at once, instead of waiting for the previous flag */
+/*  to finish downloading first, and are then processed in whatever order they arrive */
+static void FetchFlagsTask_Download(struct Flag* flag) {
 	cc_string url; char urlBuffer[URL_MAX_SIZE];
 	String_InitArray(url, urlBuffer);
 
-	if (FetchFlagsTask.Base.working)        return;
-	if (FetchFlagsTask.count == flagsCount) return;
-
-	LWebTask_Reset(&FetchFlagsTask.Base);
 	String_Format2(&url, RESOURCE_SERVER "/img/flags/%r%r.png",
-			&flags[FetchFlagsTask.count].country[0], &flags[FetchFlagsTask.count].country[1]);
-
-	FetchFlagsTask.Base.Handle = FetchFlagsTask_Handle;
-	FetchFlagsTask.Base.reqID  = Http_AsyncGetData(&url, 0);
+			&flag->country[0], &flag->country[1]);
+	flag->reqID = Http_AsyncGetData(&url, 0);
 }
 
 static void FetchFlagsTask_Ensure(void) {
@@ -679,24 +684,43 @@ void FetchFlagsTask_Add(const struct ServerInfo* server) {
 	flags[flagsCount].country[1] = server->country[1];
 	flags[flagsCount].meta = NULL;
 
+	FetchFlagsTask_Download(&flags[flagsCount]);
 	flagsCount++;
-	FetchFlagsTask_DownloadNext();
+}
+
+void FetchFlagsTask_Tick(void) {
+	struct HttpRequest item;
+	int i;
+	if (FetchFlagsTask.count == flagsCount) return;
+
+	for (i = 0; i < flagsCount; i++) 
+	{
+		if (!flags[i].reqID) continue;
+		if (!Http_GetResult(flags[i].reqID, &item)) continue;
+
+		if (item.success) LBackend_DecodeFlag(&flags[i], item.data, item.size);
+		HttpRequest_Free(&item);
+
+		flags[i].reqID = 0;
+		FetchFlagsTask.count++;
+	}
 }
 
 struct Flag* Flags_Get(const struct ServerInfo* server) {
 	int i;
-	for (i = 0; i < FetchFlagsTask.count; i++) 
+	for (i = 0; i < flagsCount; i++) 
 	{
 		if (flags[i].country[0] != server->country[0]) continue;
 		if (flags[i].country[1] != server->country[1]) continue;
-		return &flags[i];
+		return flags[i].reqID ? NULL : &flags[i];
 	}
 	return NULL;
 }
 
 void Flags_Free(void) {
 	int i;
-	for (i = 0; i < FetchFlagsTask.count; i++) {
+	for (i = 0; i < flagsCount; i++) {
+		if (flags[i].reqID) Http_TryCancel(flags[i].reqID);
 		Mem_Free(flags[i].bmp.scan0);
 	}
 
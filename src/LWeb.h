@@ -41,6 +41,7 @@ struct ServerInfo {
 	char country[2];
 	int _order; /* (internal) order in servers table after filtering */
 	char _hashBuffer[32],   _nameBuffer[STRING_SIZE];
+	char _lowerName[STRING_SIZE]; /* (internal) name in lowercase, for filtering */
 	char _ipBuffer[16],     _mppassBuffer[STRING_SIZE];
 	char _softBuffer[STRING_SIZE];
 };
@@ -50,6 +51,7 @@ struct Flag {
 	struct Bitmap bmp;
 	char country[2]; /* ISO 3166-1 alpha-2 */
 	void* meta; /* Backend specific meta */
+	int reqID;  /* (internal) ID of request downloading this flag, 0 once finished */
 };
 
 struct LWebTask {
@@ -96,6 +98,7 @@ extern struct FetchServersData {
 	struct ServerInfo* servers; /* List of all public servers on server list. */
 	cc_uint16* orders;          /* Order of each server (after sorting) */
 	int numServers;             /* Number of public servers. */
+	int version;                /* Incremented whenever servers list is replaced */
 } FetchServersTask;
 void FetchServersTask_Run(void);
 void FetchServersTask_ResetOrder(void);
@@ -121,13 +124,14 @@ void FetchUpdateTask_Run(cc_bool release, int buildIndex);
 
 
 extern struct FetchFlagsData { 
-	struct LWebTask Base;
-	/* Number of flags downloaded. */
+	/* Number of flags that have finished downloading. */
 	int count;
 } FetchFlagsTask;
 
 /* Asynchronously downloads the flag associated with the given server's country. */
 void FetchFlagsTask_Add(const struct ServerInfo* server);
+/* Processes any flags that have finished downloading since the last call. */
+void FetchFlagsTask_Tick(void);
 /* Gets the country flag associated with the given server's country. */
 struct Flag* Flags_Get(const struct ServerInfo* server);
 /* Frees all flag bitmaps. */
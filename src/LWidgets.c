@@ -675,6 +675,11 @@ void LTable_Add(void* screen, struct LTable* w,
 	LScreen_AddWidget(screen, w);
 }
 
+/* Filter that the current rows were filtered with */
+static char lastFilterBuffer[STRING_SIZE];
+static cc_string lastFilter = String_FromArray(lastFilterBuffer);
+static cc_bool lastShowEmpty, filterValid;
+
 void LTable_Reset(struct LTable* w) {
 	LBackend_TableMouseUp(w, 0);
 	LBackend_TableReposition(w);
@@ -683,28 +688,69 @@ void LTable_Reset(struct LTable* w) {
 	w->rowsCount  = 0;
 	w->_wheelAcc  = 0.0f;
 	w->sortingCol = -1;
+	filterValid   = false;
+}
+
+/* Whether the lowercase name of the given server contains the given lowercase text */
+static cc_bool LTable_NameContains(const struct ServerInfo* server, const cc_string* sub) {
+	const char* name = server->_lowerName;
+	int i, end = server->name.length - sub->length;
+	if (!sub->length) return true;
+
+	for (i = 0; i <= end; i++) 
+	{
+		if (name[i] != sub->buffer[0]) continue;
+		if (Mem_Equal(name + i, sub->buffer, sub->length)) return true;
+	}
+	return false;
 }
 
-static int ShouldShowServer(struct LTable* w, struct ServerInfo* server) {
-	return String_CaselessContains(&server->name, w->filter) 
+static int ShouldShowServer(struct ServerInfo* server, const cc_string* filter) {
+	return LTable_NameContains(server, filter)
 		&& (Launcher_ShowEmptyServers || server->players > 0);
 }
 
 void LTable_ApplyFilter(struct LTable* w) {
+	cc_string filter; char filterBuffer[STRING_SIZE];
+	struct ServerInfo* servers = FetchServersTask.servers;
 	int i, j, count;
+	char c;
 
+	String_InitArray(filter, filterBuffer);
+	for (i = 0; i < w->filter->length; i++) 
+	{
+		c = w->filter->buffer[i]; Char_MakeLower(c);
+		String_Append(&filter, c);
+	}
 	count = FetchServersTask.numServers;
-	for (i = 0, j = 0; i < count; i++) {
-		if (ShouldShowServer(w, Servers_Get(i))) {
-			FetchServersTask.servers[j++]._order = FetchServersTask.orders[i];
+
+	/* Rows hidden by the previous filter are also hidden by any filter containing it, */
+	/*  so e.g. typing another character only has to re-check the currently shown rows */
+	if (filterValid && lastShowEmpty == Launcher_ShowEmptyServers && String_CaselessContains(&filter, &lastFilter)) {
+		for (i = 0, j = 0; i < w->rowsCount; i++) 
+		{
+			if (ShouldShowServer(LTable_Get(i), &filter)) {
+				servers[j++]._order = servers[i]._order;
+			}
+		}
+	} else {
+		for (i = 0, j = 0; i < count; i++) 
+		{
+			if (ShouldShowServer(Servers_Get(i), &filter)) {
+				servers[j++]._order = FetchServersTask.orders[i];
+			}
 		}
 	}
 
 	w->rowsCount = j;
 	for (; j < count; j++) {
-		FetchServersTask.servers[j]._order = -100000;
+		servers[j]._order = -100000;
 	}
 
+	String_Copy(&lastFilter, &filter);
+	lastShowEmpty = Launcher_ShowEmptyServers;
+	filterValid   = true;
+
 	w->_lastRow = -1;
 	LTable_ClampTopRow(w);
 	LBackend_TableUpdate(w);
@@ -715,7 +761,8 @@ static int LTable_SortOrder(const struct ServerInfo* a, const struct ServerInfo*
 	int order;
 	if (sortingCol >= 0) {
 		order = tableColumns[sortingCol].SortOrder(a, b);
-		return tableColumns[sortingCol].invertSort ? -order : order;
+		if (tableColumns[sortingCol].invertSort) order = -order;
+		if (order) return order;
 	}
 
 	/* Default sort order. (most active server, then by highest uptime) */
@@ -723,30 +770,81 @@ static int LTable_SortOrder(const struct ServerInfo* a, const struct ServerInfo*
 	return a->uptime - b->uptime;
 }
 
-static void LTable_QuickSort(int left, int right) {
-	cc_uint16* keys = FetchServersTask.orders; cc_uint16 key;
-
-	while (left < right) {
-		int i = left, j = right;
-		struct ServerInfo* mid = Servers_Get((i + j) >> 1);
-
-		/* partition the list */
-		while (i <= j) {
-			while (LTable_SortOrder(mid, Servers_Get(i)) < 0) i++;
-			while (LTable_SortOrder(mid, Servers_Get(j)) > 0) j--;
-			QuickSort_Swap_Maybe();
+/* Stable sort, so rows that compare equal stay in the order the server list returned them in */
+static void LTable_MergeSort(cc_uint16* keys, cc_uint16* tmp, int count) {
+	struct ServerInfo* servers = FetchServersTask.servers;
+	cc_uint16* src = keys;
+	cc_uint16* dst = tmp;
+	cc_uint16* swap;
+	int width, left, mid, right, i, j, k;
+
+	for (width = 1; width < count; width *= 2) 
+	{
+		for (left = 0; left < count; left += width * 2) 
+		{
+			mid   = min(left + width,     count);
+			right = min(left + width * 2, count);
+			i = left; j = mid; k = left;
+
+			/* Only take from the right run when its row strictly sorts before */
+			while (i < mid && j < right) {
+				if (LTable_SortOrder(&servers[src[j]], &servers[src[i]]) > 0) {
+					dst[k++] = src[j++];
+				} else {
+					dst[k++] = src[i++];
+				}
+			}
+			while (i < mid)   dst[k++] = src[i++];
+			while (j < right) dst[k++] = src[j++];
 		}
-		/* recurse into the smaller subset */
-		QuickSort_Recurse(LTable_QuickSort)
+		swap = src; src = dst; dst = swap;
 	}
+	if (src != keys) Mem_Copy(keys, src, count * 2);
+}
+
+/* Sorted orders are cached per column and direction, so switching between */
+/*  columns only needs to sort the servers list once per column */
+#define SORT_CACHE_SLOTS ((Array_Elems(tableColumns) + 1) * 2)
+static cc_uint16* sortCache;
+static cc_bool sortCached[SORT_CACHE_SLOTS];
+static int sortCacheVersion = -1;
+
+static void LTable_CheckSortCache(int count) {
+	if (sortCacheVersion == FetchServersTask.version) return;
+	sortCacheVersion = FetchServersTask.version;
+
+	Mem_Free(sortCache);
+	sortCache = NULL;
+	Mem_Set(sortCached, 0, sizeof(sortCached));
+
+	if (!count) return;
+	/* Extra slot at end is used as temp buffer for sorting */
+	sortCache = (cc_uint16*)Mem_Alloc((SORT_CACHE_SLOTS + 1) * count, 2, "servers sort cache");
 }
 
 void LTable_Sort(struct LTable* w) {
-	sortingCol = w->sortingCol;
-	FetchServersTask_ResetOrder();
+	int count = FetchServersTask.numServers;
+	cc_uint16* orders = FetchServersTask.orders;
+	cc_uint16* cached;
+	int slot;
 
-	if (FetchServersTask.numServers)
-		LTable_QuickSort(0, FetchServersTask.numServers - 1);
+	sortingCol = w->sortingCol;
+	LTable_CheckSortCache(count);
+	filterValid = false;
+
+	if (count) {
+		slot   = (sortingCol + 1) * 2 + (sortingCol >= 0 && tableColumns[sortingCol].invertSort);
+		cached = sortCache + slot * count;
+
+		if (!sortCached[slot]) {
+			FetchServersTask_ResetOrder();
+			LTable_MergeSort(orders, sortCache + SORT_CACHE_SLOTS * count, count);
+			Mem_Copy(cached, orders, count * 2);
+			sortCached[slot] = true;
+		} else {
+			Mem_Copy(orders, cached, count * 2);
+		}
+	}
 
 	LTable_ApplyFilter(w);
 	LTable_ShowSelected(w);
@@ -12,6 +12,7 @@
 #include "ExtMath.h"
 #include "Options.h"
 #include "Builder.h"
+#include "Utils.h"
 
 const char* const LightingMode_Names[LIGHTING_MODE_COUNT] = { "Classic", "Fancy" };
 
@@ -58,7 +59,7 @@ static int ClassicLighting_CalcHeightAt(int x, int maxY, int z, int hIndex) {
 	if (World.IDMask <= 0xFF) {
 		ClassicLighting_CalcBody(World.Blocks[i]);
 	} else {
-		ClassicLighting_CalcBody(World.Blocks[i] | (World.Blocks2[i] << 8));
+		ClassicLighting_CalcBody(World_GetRawBlock(i));
 	}
 #endif
 
@@ -117,6 +118,64 @@ static PackedCol ClassicLighting_Color_ZSide_Fast(int x, int y, int z) {
 	return y > classic_heightmap[Lighting_Pack(x, z)] ? Env.SunZSide : Env.ShadowZSide;
 }
 
+#define HEIGHTMAP_BAND_ROWS 16
+
+/* Scans down one Y layer at a time, so that blocks are read sequentially instead of */
+/*  jumping a whole layer between each block like when calculating a single column */
+#define ClassicLighting_BandBody(get_block)\
+for (y = World.Height - 1; y >= 0 && left; y--) {\
+	index  = World_Pack(0, y, zBeg);\
+	hIndex = Lighting_Pack(0, zBeg);\
+\
+	for (i = 0; i < count; i++, index++, hIndex++) {\
+		if (classic_heightmap[hIndex] != HEIGHT_UNCALCULATED) continue;\
+		block = get_block;\
+		if (!Blocks.BlocksLight[block]) continue;\
+\
+		offset = (Blocks.LightOffset[block] >> LIGHT_FLAG_SHADES_FROM_BELOW) & 1;\
+		classic_heightmap[hIndex] = (cc_int16)(y - offset);\
+		left--;\
+	}\
+}
+
+/* Calculates the light height of every column in a band of Z rows */
+static void ClassicLighting_CalcBand(int job, void* obj) {
+	int zBeg  = job * HEIGHTMAP_BAND_ROWS;
+	int zEnd  = min(zBeg + HEIGHTMAP_BAND_ROWS, World.Length);
+	int count = (zEnd - zBeg) * World.Width;
+	int left  = count;
+	int i, y, index, hIndex, offset;
+	BlockID block;
+
+	hIndex = Lighting_Pack(0, zBeg);
+	for (i = 0; i < count; i++) {
+		classic_heightmap[hIndex + i] = HEIGHT_UNCALCULATED;
+	}
+
+#ifndef EXTENDED_BLOCKS
+	ClassicLighting_BandBody(World.Blocks[index]);
+#else
+	if (World.IDMask <= 0xFF) {
+		ClassicLighting_BandBody(World.Blocks[index]);
+	} else {
+		ClassicLighting_BandBody(World_GetRawBlock(index));
+	}
+#endif
+
+	if (!left) return;
+	hIndex = Lighting_Pack(0, zBeg);
+	for (i = 0; i < count; i++) {
+		if (classic_heightmap[hIndex + i] == HEIGHT_UNCALCULATED) classic_heightmap[hIndex + i] = -10;
+	}
+}
+
+/* Calculates the whole heightmap up front when a map is loaded, rather than lazily as chunks get built */
+/* After this it is kept up to date by ClassicLighting_OnBlockChanged */
+static void ClassicLighting_CalcHeightmap(void) {
+	WorkerPool_Run(ClassicLighting_CalcBand, NULL, 
+					(World.Length + HEIGHTMAP_BAND_ROWS - 1) / HEIGHTMAP_BAND_ROWS);
+}
+
 void ClassicLighting_Refresh(void) {
 	int i;
 	for (i = 0; i < World.Width * World.Length; i++) {
@@ -185,7 +244,7 @@ static cc_bool ClassicLighting_NeedsNeighour(BlockID block, int i, int minY, int
 	if (World.IDMask <= 0xFF) {
 		ClassicLighting_NeedsNeighourBody(World.Blocks[i]);
 	} else {
-		ClassicLighting_NeedsNeighourBody(World.Blocks[i] | (World.Blocks2[i] << 8));
+		ClassicLighting_NeedsNeighourBody(World_GetRawBlock(i));
 	}
 #endif
 	return false;
@@ -352,7 +411,7 @@ static cc_bool Heightmap_CalculateCoverage(int x1, int z1, int xCount, int zCoun
 	if (World.IDMask <= 0xFF) {
 		Heightmap_CalculateBody(World.Blocks[mapIndex]);
 	} else {
-		Heightmap_CalculateBody(World.Blocks[mapIndex] | (World.Blocks2[mapIndex] << 8));
+		Heightmap_CalculateBody(World_GetRawBlock(mapIndex));
 	}
 #endif
 	return false;
@@ -394,7 +453,7 @@ void ClassicLighting_FreeState(void) {
 void ClassicLighting_AllocState(void) {
 	classic_heightmap = (cc_int16*)Mem_TryAlloc(World.Width * World.Length, 2);
 	if (classic_heightmap) {
-		ClassicLighting_Refresh();
+		ClassicLighting_CalcHeightmap();
 	} else {
 		World_OutOfMemory();
 	}
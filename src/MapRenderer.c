@@ -106,6 +106,23 @@ static void CheckWeather(float delta) {
 	Gfx_SetAlphaBlending(false);
 }
 
+#if defined CC_BUILD_COMPACTCHUNKS
+	#define CHUNK_VERTEX_FORMAT VERTEX_FORMAT_CHUNK
+#else
+	#define CHUNK_VERTEX_FORMAT VERTEX_FORMAT_TEXTURED
+#endif
+
+#if CC_GFX_BACKEND != CC_GFX_BACKEND_GL11
+static void MapRenderer_BindChunkVb(struct ChunkInfo* info) {
+#ifdef CC_BUILD_COMPACTCHUNKS
+	/* Compact chunk vertices are relative to the chunk's origin */
+	Gfx_SetChunkOrigin(info->centreX - HALF_CHUNK_SIZE, info->centreY - HALF_CHUNK_SIZE,
+						info->centreZ - HALF_CHUNK_SIZE);
+#endif
+	Gfx_BindVb_Textured(info->vb);
+}
+#endif
+
 #if CC_GFX_BACKEND == CC_GFX_BACKEND_GL11
 	#define DrawFace(face, ign)    Gfx_BindVb(part.vbs[face]); Gfx_DrawIndexedTris_T2fC4b(0, 0);
 	#define DrawFaces(f1, f2, ign) DrawFace(f1, ign); DrawFace(f2, ign);
@@ -144,7 +161,7 @@ static void RenderNormalBatch(int batch) {
 		hasNormParts[batch] = true;
 
 #if CC_GFX_BACKEND != CC_GFX_BACKEND_GL11
-		Gfx_BindVb_Textured(info->vb);
+		MapRenderer_BindChunkVb(info);
 #endif
 
 		offset  = part.offset + part.spriteCount;
@@ -198,7 +215,7 @@ void MapRenderer_RenderNormal(float delta) {
 	int batch;
 	if (!mapChunks) return;
 
-	Gfx_SetVertexFormat(VERTEX_FORMAT_TEXTURED);
+	Gfx_SetVertexFormat(CHUNK_VERTEX_FORMAT);
 	Gfx_SetAlphaTest(true);
 	
 	Gfx_EnableMipmaps();
@@ -248,7 +265,7 @@ static void RenderTranslucentBatch(int batch) {
 		hasTranParts[batch] = true;
 
 #if CC_GFX_BACKEND != CC_GFX_BACKEND_GL11
-		Gfx_BindVb_Textured(info->vb);
+		MapRenderer_BindChunkVb(info);
 #endif
 
 		offset  = part.offset;
@@ -274,7 +291,7 @@ void MapRenderer_RenderTranslucent(float delta) {
 
 	/* First fill depth buffer */
 	vertices = Game_Vertices;
-	Gfx_SetVertexFormat(VERTEX_FORMAT_TEXTURED);
+	Gfx_SetVertexFormat(CHUNK_VERTEX_FORMAT);
 	Gfx_SetAlphaBlending(false);
 	Gfx_DepthOnlyRendering(true);
 
@@ -713,6 +730,20 @@ void MapRenderer_RefreshChunk(int cx, int cy, int cz) {
 	ChunkInfo_Refresh(chunk);
 }
 
+#ifdef CC_BUILD_BENCH
+int MapRenderer_BuildAllChunks(void) {
+	int i, chunkUpdates = 0;
+	if (!mapChunks || !World.Blocks) return 0;
+	DeleteChunks();
+
+	for (i = 0; i < chunksCount; i++) 
+	{
+		BuildChunk(&mapChunks[i], &chunkUpdates);
+	}
+	return chunkUpdates;
+}
+#endif
+
 void MapRenderer_OnBlockChanged(int x, int y, int z, BlockID block) {
 	int cx = x >> CHUNK_SHIFT, cy = y >> CHUNK_SHIFT, cz = z >> CHUNK_SHIFT;
 	struct ChunkInfo* chunk;
@@ -78,5 +78,10 @@ void MapRenderer_OnBlockChanged(int x, int y, int z, BlockID block);
 /* Deletes all chunks and resets internal state. */
 void MapRenderer_Refresh(void);
 
+#ifdef CC_BUILD_BENCH
+/* Rebuilds the meshes of every chunk in the world, returning the number of chunks built. */
+int MapRenderer_BuildAllChunks(void);
+#endif
+
 CC_END_HEADER
 #endif
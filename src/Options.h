@@ -27,6 +27,7 @@ Copyright 2014-2025 ClassiCube | Licensed under BSD-3
 #define OPT_SMOOTH_LIGHTING "gfx-smoothlighting"
 #define OPT_LIGHTING_MODE "gfx-lightingmode"
 #define OPT_MIPMAPS "gfx-mipmaps"
+#define OPT_GPU_MIPMAPS "gfx-gpu-mipmaps"
 #define OPT_CHAT_LOGGING "chat-logging"
 #define OPT_WINDOW_WIDTH "window-width"
 #define OPT_WINDOW_HEIGHT "window-height"
@@ -80,9 +81,12 @@ Copyright 2014-2025 ClassiCube | Licensed under BSD-3
 #define OPT_TOUCH_SCALE "gui-touchscale"
 #define OPT_HTTP_ONLY "http-no-https"
 #define OPT_HTTPS_VERIFY "https-verify"
+#define OPT_NET_CAPTURE "net-capture-file"
+#define OPT_NET_REPLAY_SPEED "net-replay-speed"
 #define OPT_SKIN_SERVER "http-skinserver"
 #define OPT_RAW_INPUT "win-raw-input"
 #define OPT_DPI_SCALING "win-dpi-scaling"
+#define OPT_TERMINAL_256COLOR "win-terminal-256color"
 #define OPT_GAME_VERSION "game-version"
 #define OPT_INV_SCROLLBAR_SCALE "inv-scrollbar-scale"
 #define OPT_ANAGLYPH3D "anaglyph-3d"
@@ -7,6 +7,8 @@
 #include "Funcs.h"
 #include "Logger.h"
 #include "Entity.h"
+#include "Utils.h"
+#include "Constants.h"
 
 
 /*########################################################################################################################*
@@ -128,9 +130,118 @@ cc_bool Intersection_RayIntersectsBox(Vec3 origin, Vec3 invDir, Vec3 min, Vec3 m
 *#########################################################################################################################*/
 #define SEARCHER_STATES_MIN 64
 static struct SearcherState searcherDefaultStates[SEARCHER_STATES_MIN];
-static cc_uint32 searcherCapacity = SEARCHER_STATES_MIN;
+static int searcherCapacity = SEARCHER_STATES_MIN;
 struct SearcherState* Searcher_States = searcherDefaultStates;
 
+/* Whether each chunk of the map is known to only contain air. Computed lazily, */
+/*  and reset to unknown whenever a block in the chunk changes */
+#define SEARCHER_CHUNK_UNKNOWN 0
+#define SEARCHER_CHUNK_EMPTY   1
+#define SEARCHER_CHUNK_BLOCKS  2
+static cc_uint8* searcherChunks;
+
+static cc_bool Searcher_CalcChunkEmpty(int cx, int cy, int cz) {
+	int x1 = cx << CHUNK_SHIFT, x2 = min(x1 + CHUNK_SIZE, World.Width);
+	int y1 = cy << CHUNK_SHIFT, y2 = min(y1 + CHUNK_SIZE, World.Height);
+	int z1 = cz << CHUNK_SHIFT, z2 = min(z1 + CHUNK_SIZE, World.Length);
+	int x, y, z;
+
+	for (y = y1; y < y2; y++)
+		for (z = z1; z < z2; z++)
+			for (x = x1; x < x2; x++)
+	{
+		if (World_GetBlock(x, y, z) != BLOCK_AIR) return false;
+	}
+	return true;
+}
+
+static cc_bool Searcher_IsChunkEmpty(int cx, int cy, int cz) {
+	cc_uint8* state = &searcherChunks[World_ChunkPack(cx, cy, cz)];
+
+	if (*state == SEARCHER_CHUNK_UNKNOWN) {
+		*state = Searcher_CalcChunkEmpty(cx, cy, cz) ? SEARCHER_CHUNK_EMPTY : SEARCHER_CHUNK_BLOCKS;
+	}
+	return *state == SEARCHER_CHUNK_EMPTY;
+}
+
+/* Whether all chunks between the given X chunk coordinates only contain air */
+static cc_bool Searcher_IsChunkRowEmpty(int cx1, int cx2, int cy, int cz) {
+	int cx;
+	for (cx = cx1; cx <= cx2; cx++)
+	{
+		if (!Searcher_IsChunkEmpty(cx, cy, cz)) return false;
+	}
+	return true;
+}
+
+void Searcher_OnBlockChanged(int x, int y, int z) {
+	if (!searcherChunks) return;
+	searcherChunks[World_ChunkPack(x >> CHUNK_SHIFT, y >> CHUNK_SHIFT, z >> CHUNK_SHIFT)] = SEARCHER_CHUNK_UNKNOWN;
+}
+
+static void Searcher_AddState(struct Entity* entity, struct AABB* entityBB, struct AABB* entityExtentBB, 
+								int x, int y, int z, BlockID block, int* count) {
+	struct SearcherState* curState;
+	struct AABB blockBB;
+	float xx, yy, zz, tx, ty, tz;
+
+	xx = (float)x; yy = (float)y; zz = (float)z;
+	blockBB.Min = Blocks.MinBB[block];
+	blockBB.Min.x += xx; blockBB.Min.y += yy; blockBB.Min.z += zz;
+	blockBB.Max = Blocks.MaxBB[block];
+	blockBB.Max.x += xx; blockBB.Max.y += yy; blockBB.Max.z += zz;
+
+	if (!AABB_Intersects(entityExtentBB, &blockBB)) return; /* necessary for non whole blocks. (slabs) */
+	Searcher_CalcTime(&entity->Velocity, entityBB, &blockBB, &tx, &ty, &tz);
+	if (tx > 1.0f || ty > 1.0f || tz > 1.0f) return;
+
+	/* Only grow based on how many blocks are actually reachable, */
+	/*  instead of the volume of the extent (mostly air with speed hacks) */
+	if (*count == searcherCapacity) {
+		Utils_Resize((void**)&Searcher_States, &searcherCapacity,
+					sizeof(struct SearcherState), SEARCHER_STATES_MIN, searcherCapacity);
+	}
+
+	curState = &Searcher_States[(*count)++];
+	curState->x = (x << 3) | (block  & 0x007);
+	curState->y = (y << 4) | ((block & 0x078) >> 3);
+	curState->z = (z << 3) | ((block & 0x380) >> 7);
+	curState->tSquared = tx * tx + ty * ty + tz * tz;
+}
+
+/* Adds candidates for a row of blocks that is entirely inside the map, skipping chunks that only contain air */
+static void Searcher_FindInRow(struct Entity* entity, struct AABB* entityBB, struct AABB* entityExtentBB,
+								int x1, int x2, int y, int z, cc_bool skipEmpty, int* count) {
+	int rowIndex = World_Pack(0, y, z);
+	int cy = y >> CHUNK_SHIFT, cz = z >> CHUNK_SHIFT;
+	int x, chunkEnd;
+	BlockID block;
+
+	for (x = x1; x <= x2; ) {
+		chunkEnd = min(x2, x | CHUNK_MASK);
+		if (skipEmpty && Searcher_IsChunkEmpty(x >> CHUNK_SHIFT, cy, cz)) { x = chunkEnd + 1; continue; }
+
+		for (; x <= chunkEnd; x++) {
+			block = World_GetRawBlock(rowIndex + x);
+			if (Blocks.Collide[block] != COLLIDE_SOLID) continue;
+			Searcher_AddState(entity, entityBB, entityExtentBB, x, y, z, block, count);
+		}
+	}
+}
+
+/* Adds candidates for blocks that are outside the map (i.e. bedrock below/at the sides, air above) */
+static void Searcher_FindOutside(struct Entity* entity, struct AABB* entityBB, struct AABB* entityExtentBB,
+								int x1, int x2, int y, int z, int* count) {
+	BlockID block;
+	int x;
+
+	for (x = x1; x <= x2; x++) {
+		block = World_GetPhysicsBlock(x, y, z);
+		if (Blocks.Collide[block] != COLLIDE_SOLID) continue;
+		Searcher_AddState(entity, entityBB, entityExtentBB, x, y, z, block, count);
+	}
+}
+
 static void Searcher_QuickSort(int left, int right) {
 	struct SearcherState* keys = Searcher_States; struct SearcherState key;
 
@@ -152,14 +263,10 @@ static void Searcher_QuickSort(int left, int right) {
 int Searcher_FindReachableBlocks(struct Entity* entity, struct AABB* entityBB, struct AABB* entityExtentBB) {
 	Vec3 vel = entity->Velocity;
 	IVec3 min, max;
-	cc_uint32 elements;
-	struct SearcherState* curState;
-	int count;
-
-	BlockID block;
-	struct AABB blockBB;
-	float xx, yy, zz, tx, ty, tz;
-	int x, y, z;
+	int count = 0;
+	int inMinX, inMaxX, cx1, cx2;
+	int y, z, chunkEnd;
+	cc_bool skipEmpty;
 
 	Entity_GetBounds(entity, entityBB);
 	/* Exact maximum extent the entity can reach, and the equivalent map coordinates. */
@@ -173,42 +280,49 @@ int Searcher_FindReachableBlocks(struct Entity* entity, struct AABB* entityBB, s
 
 	IVec3_Floor(&min, &entityExtentBB->Min);
 	IVec3_Floor(&max, &entityExtentBB->Max);
-	elements = (max.x - min.x + 1) * (max.y - min.y + 1) * (max.z - min.z + 1);
 
-	if (elements > searcherCapacity) {
-		Searcher_Free();
-		searcherCapacity = elements;
-		Searcher_States  = (struct SearcherState*)Mem_Alloc(elements, sizeof(struct SearcherState), "collision search states");
+	/* Air can't be collided with, so chunks that are all air can be skipped */
+	/*  (candidates are still found in exactly the same order as scanning every block) */
+	skipEmpty = Blocks.Collide[BLOCK_AIR] != COLLIDE_SOLID;
+	if (skipEmpty && !searcherChunks) {
+		searcherChunks = (cc_uint8*)Mem_TryAllocCleared(World.ChunksCount, 1);
+		skipEmpty      = searcherChunks != NULL;
 	}
-	curState = Searcher_States;
+
+	/* X range of the extent that is inside the map */
+	inMinX = max(min.x, 0); inMaxX = min(max.x, World.MaxX);
+	cx1    = inMinX >> CHUNK_SHIFT; cx2 = inMaxX >> CHUNK_SHIFT;
 
 	/* Order loops so that we minimise cache misses */
 	for (y = min.y; y <= max.y; y++) {
 		for (z = min.z; z <= max.z; z++) {
-			for (x = min.x; x <= max.x; x++) {
-				block = World_GetPhysicsBlock(x, y, z);
-				if (Blocks.Collide[block] != COLLIDE_SOLID) continue;
-
-				xx = (float)x; yy = (float)y; zz = (float)z;
-				blockBB.Min = Blocks.MinBB[block];
-				blockBB.Min.x += xx; blockBB.Min.y += yy; blockBB.Min.z += zz;
-				blockBB.Max = Blocks.MaxBB[block];
-				blockBB.Max.x += xx; blockBB.Max.y += yy; blockBB.Max.z += zz;
-
-				if (!AABB_Intersects(entityExtentBB, &blockBB)) continue; /* necessary for non whole blocks. (slabs) */
-				Searcher_CalcTime(&vel, entityBB, &blockBB, &tx, &ty, &tz);
-				if (tx > 1.0f || ty > 1.0f || tz > 1.0f) continue;
-
-				curState->x = (x << 3) | (block  & 0x007);
-				curState->y = (y << 4) | ((block & 0x078) >> 3);
-				curState->z = (z << 3) | ((block & 0x380) >> 7);
-				curState->tSquared = tx * tx + ty * ty + tz * tz;
-				curState++;
+			if (y < 0 || z < 0 || z >= World.Length || inMinX > inMaxX || (y >= World.Height && !skipEmpty)) {
+				Searcher_FindOutside(entity, entityBB, entityExtentBB, min.x, max.x, y, z, &count);
+				continue;
 			}
+
+			/* Above the map is only air, apart from bedrock around the sides */
+			if (y >= World.Height) {
+				Searcher_FindOutside(entity, entityBB, entityExtentBB, min.x, inMinX - 1, y, z, &count);
+				Searcher_FindOutside(entity, entityBB, entityExtentBB, inMaxX + 1, max.x, y, z, &count);
+				continue;
+			}
+
+			/* Skip the rest of the Z rows in this chunk when they are only air */
+			if (skipEmpty && min.x >= 0 && max.x <= World.MaxX
+					&& Searcher_IsChunkRowEmpty(cx1, cx2, y >> CHUNK_SHIFT, z >> CHUNK_SHIFT)) {
+				chunkEnd = min(max.z, min(z | CHUNK_MASK, World.MaxZ));
+				z = chunkEnd; continue;
+			}
+
+			/* Read blocks directly from the map when inside it, */
+			/*  rather than bounds checking every single block in the extent */
+			Searcher_FindOutside(entity, entityBB, entityExtentBB, min.x, inMinX - 1, y, z, &count);
+			Searcher_FindInRow(entity,   entityBB, entityExtentBB, inMinX, inMaxX, y, z, skipEmpty, &count);
+			Searcher_FindOutside(entity, entityBB, entityExtentBB, inMaxX + 1, max.x, y, z, &count);
 		}
 	}
 
-	count = (int)(curState - Searcher_States);
 	if (count) Searcher_QuickSort(0, count - 1);
 	return count;
 }
@@ -238,6 +352,9 @@ void Searcher_CalcTime(Vec3* vel, struct AABB *entityBB, struct AABB* blockBB, f
 }
 
 void Searcher_Free(void) {
+	Mem_Free(searcherChunks);
+	searcherChunks = NULL;
+
 	if (Searcher_States != searcherDefaultStates) Mem_Free(Searcher_States);
 	Searcher_States  = searcherDefaultStates;
 	searcherCapacity = SEARCHER_STATES_MIN;
@@ -39,6 +39,8 @@ struct SearcherState { int x, y, z; float tSquared; };
 extern struct SearcherState* Searcher_States;
 int Searcher_FindReachableBlocks(struct Entity* entity, struct AABB* entityBB, struct AABB* entityExtentBB);
 void Searcher_CalcTime(Vec3* vel, struct AABB *entityBB, struct AABB* blockBB, float* tx, float* ty, float* tz);
+/* Marks the chunk containing the given block as needing to be checked again for only containing air */
+void Searcher_OnBlockChanged(int x, int y, int z);
 void Searcher_Free(void);
 
 CC_END_HEADER
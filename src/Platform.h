@@ -310,6 +310,12 @@ CC_API void Thread_Detach(void* handle);
 /* Blocks the current thread, until the given thread has finished. */
 /* NOTE: This cannot be used on a thread that has been detached. */
 CC_API void Thread_Join(void* handle);
+#if defined CC_BUILD_WIN || defined CC_BUILD_POSIX
+/* Returns the number of CPU cores that threads can run on, or 0 if unknown. */
+int Thread_CoreCount(void);
+#else
+#define Thread_CoreCount() 0
+#endif
 
 
 /*########################################################################################################################*
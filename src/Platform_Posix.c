@@ -441,6 +441,15 @@ cc_result File_Length(cc_file file, cc_uint32* len) {
 *#########################################################################################################################*/
 void Thread_Sleep(cc_uint32 milliseconds) { usleep(milliseconds * 1000); }
 
+int Thread_CoreCount(void) {
+#ifdef _SC_NPROCESSORS_ONLN
+	long count = sysconf(_SC_NPROCESSORS_ONLN);
+	return count > 0 ? (int)count : 0;
+#else
+	return 0;
+#endif
+}
+
 #ifdef CC_BUILD_ANDROID
 /* All threads using JNI must detach BEFORE they exit */
 /* (see https://developer.android.com/training/articles/perf-jni#threads */
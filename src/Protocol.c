@@ -359,6 +359,10 @@ struct MapState {
 static struct MapState map1;
 #ifdef EXTENDED_BLOCKS
 static struct MapState map2;
+/* Upper 8 bits of blocks are decompressed one page at a time, and only pages with any non-zero bits are kept */
+static BlockRaw** map2_pages;
+static BlockRaw map2_page[WORLD_UPPER_PAGE_SIZE];
+#define MapState_UpperPagesCount() ((map_volume + WORLD_UPPER_MASK) >> WORLD_UPPER_SHIFT)
 #endif
 
 static void DisconnectInvalidMap(cc_result res) {
@@ -386,14 +390,66 @@ static CC_INLINE void MapState_SkipHeader(struct MapState* m) {
 }
 
 static void FreeMapStates(void) {
+	int i;
 	Mem_Free(map1.blocks);
 	map1.blocks = NULL;
 #ifdef EXTENDED_BLOCKS
-	Mem_Free(map2.blocks);
-	map2.blocks = NULL;
+	if (!map2_pages) return;
+
+	for (i = 0; i < MapState_UpperPagesCount(); i++) Mem_Free(map2_pages[i]);
+	Mem_Free(map2_pages);
+	map2_pages = NULL;
 #endif
 }
 
+static void MapState_OutOfMemory(struct MapState* m) {
+	Window_ShowDialog("Out of memory", "Not enough free memory to join that map.\nTry joining a different map.");
+	m->allocFailed = true;
+}
+
+#ifdef EXTENDED_BLOCKS
+static cc_bool MapState_StoreUpperPage(int page, int len) {
+	BlockRaw* data;
+	int i;
+
+	for (i = 0; i < len && !map2_page[i]; i++) { }
+	if (i == len) return true;
+
+	if (!map2_pages) {
+		map2_pages = (BlockRaw**)Mem_TryAllocCleared(MapState_UpperPagesCount(), sizeof(BlockRaw*));
+		if (!map2_pages) return false;
+	}
+
+	data = (BlockRaw*)Mem_TryAllocCleared(WORLD_UPPER_PAGE_SIZE, 1);
+	if (!data) return false;
+
+	Mem_Copy(data, map2_page, len);
+	map2_pages[page] = data;
+	return true;
+}
+
+static cc_result MapState_ReadUpper(struct MapState* m) {
+	cc_uint32 left, read;
+	int offset;
+	cc_result res;
+
+	while (m->index < map_volume)
+	{
+		offset = m->index & WORLD_UPPER_MASK;
+		left   = min(WORLD_UPPER_PAGE_SIZE - offset, map_volume - m->index);
+		res    = m->stream.Read(&m->stream, &map2_page[offset], left, &read);
+		m->index += read;
+
+		/* Page is only checked for non-zero bits once all of it has been decompressed */
+		if (read == left && !MapState_StoreUpperPage((m->index - 1) >> WORLD_UPPER_SHIFT, offset + read)) {
+			MapState_OutOfMemory(m); return 0;
+		}
+		if (res || !read) return res;
+	}
+	return 0;
+}
+#endif
+
 static cc_result MapState_Read(struct MapState* m) {
 	cc_uint32 left, read;
 	cc_result res;
@@ -411,15 +467,14 @@ static cc_result MapState_Read(struct MapState* m) {
 	}
 
 	if (!map_volume) map_volume = Stream_GetU32_BE(m->size);
+#ifdef EXTENDED_BLOCKS
+	if (m == &map2) return MapState_ReadUpper(m);
+#endif
 
 	if (!m->blocks) {
 		m->blocks = (BlockRaw*)Mem_TryAlloc(map_volume, 1);
 		/* unlikely but possible */
-		if (!m->blocks) {
-			Window_ShowDialog("Out of memory", "Not enough free memory to join that map.\nTry joining a different map.");
-			m->allocFailed = true;
-			return 0;
-		}
+		if (!m->blocks) { MapState_OutOfMemory(m); return 0; }
 	}
 
 	left = map_volume - m->index;
@@ -637,11 +692,11 @@ static void Classic_LevelFinalise(cc_uint8* data) {
 	}
 	
 #ifdef EXTENDED_BLOCKS
-	/* defer allocation of second map array if possible */
-	if (IsSupported(extBlocks_Ext) && map2.blocks) {
-		World_SetMapUpper(map2.blocks);
+	/* map2_pages is NULL when no blocks above 255 were sent */
+	if (map2_pages) {
+		World_SetMapUpperPages(map2_pages, MapState_UpperPagesCount());
 	}
-	map2.blocks = NULL;
+	map2_pages = NULL;
 #endif
 	World_SetNewMap(map1.blocks, width, height, length);
 	map1.blocks  = NULL;
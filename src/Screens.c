@@ -70,8 +70,9 @@ CC_NOINLINE static cc_bool IsOnlyChatActive(void) {
 static struct HUDScreen {
 	Screen_Body
 	struct FontDesc font;
-	struct TextWidget line1, line2;
+	struct TextWidget line1, line2, profLine;
 	struct TextAtlas posAtlas;
+	GfxResourceID profVb;
 	float accumulator;
 	int frames, posCount;
 	cc_bool hacksChanged;
@@ -85,7 +86,7 @@ static struct HUDScreen {
 #define POSITION_VAL_CHARS 11
 /* [PREFIX] [(] [X] [,] [Y] [,] [Z] [)] */
 #define POSITION_HUD_CHARS (1 + 1 + POSITION_VAL_CHARS + 1 + POSITION_VAL_CHARS + 1 + POSITION_VAL_CHARS + 1)
-#define HUD_MAX_VERTICES (4 + TEXTWIDGET_MAX * 2 + HOTBAR_MAX_VERTICES + POSITION_HUD_CHARS * 4)
+#define HUD_MAX_VERTICES (4 + TEXTWIDGET_MAX * 3 + HOTBAR_MAX_VERTICES + POSITION_HUD_CHARS * 4)
 
 static void HUDScreen_RemakeLine1(struct HUDScreen* s) {
 	cc_string status; char statusBuffer[STRING_SIZE * 2];
@@ -125,6 +126,92 @@ static void HUDScreen_RemakeLine1(struct HUDScreen* s) {
 	s->dirty = true;
 }
 
+/* Colour of each profiler stage in the graph, and the matching colour code used in the legend */
+static const char profiler_codes[PROFILER_STAGES] = { 'c', '6', 'e', 'a', 'b', '9', 'd', 'f', '7' };
+static const PackedCol profiler_colors[PROFILER_STAGES] = {
+	PackedCol_Make(255,  85,  85, 255), PackedCol_Make(255, 170,   0, 255), PackedCol_Make(255, 255,  85, 255),
+	PackedCol_Make( 85, 255,  85, 255), PackedCol_Make( 85, 255, 255, 255), PackedCol_Make( 85,  85, 255, 255),
+	PackedCol_Make(255,  85, 255, 255), PackedCol_Make(255, 255, 255, 255), PackedCol_Make(170, 170, 170, 255)
+};
+#define PROFILER_BAR_WIDTH 2
+#define PROFILER_GRAPH_HEIGHT 100
+/* Time in milliseconds that a bar of full graph height represents */
+#define PROFILER_GRAPH_MS 50
+#define PROFILER_MAX_VERTICES (4 * 2 + PROFILER_FRAMES * PROFILER_STAGES * 4)
+
+static void HUDScreen_RemakeProfiler(struct HUDScreen* s) {
+	cc_string status; char statusBuffer[STRING_SIZE * 4];
+	int i, j, total;
+	float ms;
+	String_InitArray(status, statusBuffer);
+
+	/* Average of all recorded frames, except the one currently being recorded */
+	for (i = 0; i < PROFILER_STAGES; i++) 
+	{
+		total = 0;
+		for (j = 0; j < PROFILER_FRAMES; j++) 
+		{
+			if (j != Profiler.Frame) total += Profiler.Times[j][i];
+		}
+
+		ms = total / (1000.0f * (PROFILER_FRAMES - 1));
+		String_Format3(&status, "&%r%c %f1 ", &profiler_codes[i], Profiler_Names[i], &ms);
+	}
+	TextWidget_Set(&s->profLine, &status, &s->font);
+	s->dirty = true;
+}
+
+static void HUDScreen_MakeProfilerQuad(struct VertexColoured** vertices, int x, int y, int width, int height, PackedCol color) {
+	struct VertexColoured* v = *vertices;
+	v->x = (float)x;           v->y = (float)y;            v->z = 0; v->Col = color; v++;
+	v->x = (float)(x + width); v->y = (float)y;            v->z = 0; v->Col = color; v++;
+	v->x = (float)(x + width); v->y = (float)(y + height); v->z = 0; v->Col = color; v++;
+	v->x = (float)x;           v->y = (float)(y + height); v->z = 0; v->Col = color; v++;
+	*vertices = v;
+}
+
+/* Draws a stacked bar for each recent frame, with oldest frame on the left */
+static void HUDScreen_RenderProfiler(struct HUDScreen* s) {
+	struct VertexColoured* data;
+	struct VertexColoured* v;
+	int width = PROFILER_FRAMES * PROFILER_BAR_WIDTH;
+	int x = Game.Width - width - 2;
+	int y = s->profLine.y + s->profLine.height + 2;
+	int i, j, frame, barY, height;
+
+	if (!s->profVb) s->profVb = Gfx_CreateDynamicVb(VERTEX_FORMAT_COLOURED, PROFILER_MAX_VERTICES);
+	if (!s->profVb) return;
+
+	Gfx_SetVertexFormat(VERTEX_FORMAT_COLOURED);
+	data = (struct VertexColoured*)Gfx_LockDynamicVb(s->profVb, VERTEX_FORMAT_COLOURED, PROFILER_MAX_VERTICES);
+	v    = data;
+	HUDScreen_MakeProfilerQuad(&v, x, y, width, PROFILER_GRAPH_HEIGHT, PackedCol_Make(0, 0, 0, 127));
+
+	for (i = 0; i < PROFILER_FRAMES - 1; i++) 
+	{
+		frame = (Profiler.Frame + 1 + i) % PROFILER_FRAMES;
+		barY  = y + PROFILER_GRAPH_HEIGHT;
+
+		for (j = 0; j < PROFILER_STAGES; j++) 
+		{
+			height = Profiler.Times[frame][j] * PROFILER_GRAPH_HEIGHT / (PROFILER_GRAPH_MS * 1000);
+			height = min(height, barY - y);
+			if (height <= 0) continue;
+
+			barY -= height;
+			HUDScreen_MakeProfilerQuad(&v, x + i * PROFILER_BAR_WIDTH, barY, 
+										PROFILER_BAR_WIDTH, height, profiler_colors[j]);
+		}
+	}
+
+	/* Line showing the frame time needed for 60 FPS */
+	HUDScreen_MakeProfilerQuad(&v, x, y + PROFILER_GRAPH_HEIGHT - PROFILER_GRAPH_HEIGHT * 1000 / (PROFILER_GRAPH_MS * 60), 
+								width, 1, PackedCol_Make(255, 255, 255, 160));
+
+	Gfx_UnlockDynamicVb(s->profVb);
+	Gfx_DrawVb_IndexedTris((int)(v - data));
+}
+
 static void HUDScreen_BuildPosition(struct HUDScreen* s, struct VertexTextured* data) {
 	struct VertexTextured* cur = data;
 	struct TextAtlas* atlas = &s->posAtlas;
@@ -199,6 +286,8 @@ static void HUDScreen_ContextLost(void* screen) {
 	Elem_Free(&s->hotbar);
 	Elem_Free(&s->line1);
 	Elem_Free(&s->line2);
+	Elem_Free(&s->profLine);
+	Gfx_DeleteDynamicVb(&s->profVb);
 }
 
 static void HUDScreen_ContextRecreated(void* screen) {	
@@ -215,6 +304,7 @@ static void HUDScreen_ContextRecreated(void* screen) {
 	HUDScreen_RemakeLine1(s);
 	TextAtlas_Make(&s->posAtlas, &chars, &s->font, &prefix);
 	HUDScreen_RemakeLine2(s);
+	if (Profiler.Enabled) HUDScreen_RemakeProfiler(s);
 }
 
 int HUDScreen_LayoutHotbar(void) {
@@ -249,6 +339,8 @@ static void HUDScreen_Layout(void* screen) {
 
 	HUDScreen_LayoutHotbar();
 	Widget_Layout(line2);
+	Widget_SetLocation(&s->profLine, ANCHOR_MAX, ANCHOR_MIN, 
+						2 + DisplayInfo.ContentOffsetX, 2 + DisplayInfo.ContentOffsetY);
 }
 
 static int HUDScreen_KeyDown(void* screen, int key, struct InputDevice* device) {
@@ -308,6 +400,7 @@ static void HUDScreen_Init(void* screen) {
 	HotbarWidget_Create(&s->hotbar);
 	TextWidget_Init(&s->line1);
 	TextWidget_Init(&s->line2);
+	TextWidget_Init(&s->profLine);
 	
 	s->line1.flags  |= WIDGET_FLAG_MAINSCREEN;
 	s->line2.flags  |= WIDGET_FLAG_MAINSCREEN;
@@ -329,6 +422,7 @@ static void HUDScreen_UpdateFPS(struct HUDScreen* s, float delta) {
 	if (s->accumulator < 1.0f) return;
 
 	HUDScreen_RemakeLine1(s);
+	if (Profiler.Enabled) HUDScreen_RemakeProfiler(s);
 	s->accumulator    = 0.0f;
 	s->frames         = 0;
 	Game.ChunkUpdates = 0;
@@ -379,6 +473,7 @@ static void HUDScreen_BuildMesh(void* screen) {
 	Widget_BuildMesh(&s->line1,  ptr);
 	Widget_BuildMesh(&s->line2,  ptr);
 	Widget_BuildMesh(&s->hotbar, ptr);
+	Widget_BuildMesh(&s->profLine, ptr);
 
 	if (!Game_ClassicMode) 
 		HUDScreen_BuildPosition(s, data);
@@ -400,7 +495,7 @@ static void HUDScreen_Render(void* screen, float delta) {
 	} else if (IsOnlyChatActive() && Gui.ShowFPS) {
 		Widget_Render2(&s->line2, 8);
 		Gfx_BindTexture(s->posAtlas.tex.ID);
-		Gfx_DrawVb_IndexedTris_Range(s->posCount, 12 + HOTBAR_MAX_VERTICES, DRAW_HINT_RECT);
+		Gfx_DrawVb_IndexedTris_Range(s->posCount, 16 + HOTBAR_MAX_VERTICES, DRAW_HINT_RECT);
 		/* TODO swap these two lines back */
 	}
 
@@ -415,6 +510,12 @@ static void HUDScreen_Render(void* screen, float delta) {
 		}
 	}
 
+	if (Profiler.Enabled) {
+		Gfx_SetVertexFormat(VERTEX_FORMAT_TEXTURED);
+		Gfx_BindDynamicVb(s->vb);
+		Widget_Render2(&s->profLine, 12 + HOTBAR_MAX_VERTICES);
+		HUDScreen_RenderProfiler(s);
+	}
 	Gfx_3DS_SetRenderScreen(BOTTOM_SCREEN);
 }
 
@@ -25,12 +25,15 @@
 #include "Input.h"
 #include "Errors.h"
 #include "Options.h"
+#include "Stream.h"
 
 static char nameBuffer[STRING_SIZE];
 static char motdBuffer[STRING_SIZE];
 static char appBuffer[STRING_SIZE];
 static int ticks;
 struct _ServerConnectionData Server;
+/* Closes the underlying connection to the multiplayer server */
+static void (*Server_Close)(void);
 
 /*########################################################################################################################*
 *-----------------------------------------------------Common handlers-----------------------------------------------------*
@@ -235,6 +238,7 @@ static cc_result net_writeFailure;
 static void OnClose(void);
 
 #ifdef CC_BUILD_NETWORKING
+#define NET_READ_SIZE (4096 * 4)
 static cc_uint8  net_readBuffer[4096 * 5];
 static cc_uint8* net_readCurrent;
 static double net_lastPacket;
@@ -244,6 +248,60 @@ static cc_bool net_connecting;
 static float net_connectElapsed;
 #define NET_TIMEOUT_SECS 15
 
+
+/*########################################################################################################################*
+*-----------------------------------------------------Network capture-----------------------------------------------------*
+*#########################################################################################################################*/
+/* Network captures record all data received from the server, along with when it was received */
+/*  Format is "CCNETCAP" header, then [u32 time (ms since connecting), u32 length, data] records */
+static const cc_uint8 capture_magic[8] = { 'C','C','N','E','T','C','A','P' };
+#define CAPTURE_RECORD_SIZE 8
+
+static struct Stream capture_stream;
+static cc_bool capture_active;
+static cc_uint64 capture_start;
+
+static void NetCapture_End(void) {
+	cc_result res;
+	if (!capture_active) return;
+
+	capture_active = false;
+	res = capture_stream.Close(&capture_stream);
+	if (res) Logger_SysWarn(res, "closing network capture");
+}
+
+static void NetCapture_Begin(void) {
+	cc_string path; char pathBuffer[FILENAME_SIZE];
+	cc_result res;
+	String_InitArray(path, pathBuffer);
+
+	Options_Get(OPT_NET_CAPTURE, &path, "");
+	if (!path.length) return;
+
+	res = Stream_CreateFile(&capture_stream, &path);
+	if (res) { Logger_SysWarn2(res, "creating network capture", &path); return; }
+
+	capture_active = true;
+	capture_start  = Stopwatch_Measure();
+	res = Stream_Write(&capture_stream, capture_magic, sizeof(capture_magic));
+
+	if (res) { Logger_SysWarn2(res, "writing network capture", &path); NetCapture_End(); }
+}
+
+static void NetCapture_Write(const cc_uint8* data, cc_uint32 len) {
+	cc_uint8 header[CAPTURE_RECORD_SIZE];
+	cc_uint64 elapsed = Stopwatch_ElapsedMicroseconds(capture_start, Stopwatch_Measure());
+	cc_result res;
+
+	Stream_SetU32_LE(header + 0, (cc_uint32)(elapsed / 1000));
+	Stream_SetU32_LE(header + 4, len);
+
+	res = Stream_Write(&capture_stream, header, sizeof(header));
+	if (!res) res = Stream_Write(&capture_stream, data, len);
+	if (res) { Logger_SysWarn(res, "writing network capture"); NetCapture_End(); }
+}
+
+
 static void MPConnection_FinishConnect(void) {
 	net_connecting = false;
 	Event_RaiseVoid(&NetEvents.Connected);
@@ -251,6 +309,7 @@ static void MPConnection_FinishConnect(void) {
 
 	net_readCurrent = net_readBuffer;
 	net_lastPacket  = Game.Time;
+	NetCapture_Begin();
 	Classic_SendLogin();
 }
 
@@ -377,19 +436,59 @@ static void DisconnectInvalidOpcode(cc_uint8 opcode) {
 	Game_Disconnect(&title, &tmp); return;
 }
 
-static void MPConnection_Tick(struct ScheduledTask* task) {
+/* Processes all complete packets in the given data that was just read into net_readCurrent */
+/* Returns false if an invalid packet was encountered (and hence player was disconnected) */
+static cc_bool MPConnection_ProcessData(cc_uint32 read) {
 	Net_Handler handler;
 	cc_uint8* readEnd;
 	cc_uint8* readCur;
-	cc_uint32 read;
 	int i, remaining;
+
+	readCur        = net_readBuffer;
+	readEnd        = net_readCurrent + read;
+	net_lastPacket = Game.Time;
+
+	while (readCur < readEnd) {
+		cc_uint8 opcode = readCur[0];
+
+		/* Workaround for older D3 servers which wrote one byte too many for HackControl packets */
+		if (cpe_needD3Fix && lastOpcode == OPCODE_HACK_CONTROL && (opcode == 0x00 || opcode == 0xFF)) {
+			Platform_LogConst("Skipping invalid HackControl byte from D3 server");
+			readCur++;
+			LocalPlayer_ResetJumpVelocity(Entities.CurPlayer);
+			continue;
+		}
+
+		if (readCur + Protocol.Sizes[opcode] > readEnd) break;
+		handler = Protocol.Handlers[opcode];
+		if (!handler) { DisconnectInvalidOpcode(opcode); return false; }
+
+		lastOpcode = opcode;
+		handler(readCur + 1); /* skip opcode */
+		readCur += Protocol.Sizes[opcode];
+	}
+
+	/* Protocol packets might be split up across TCP packets */
+	/* If so, copy last few unprocessed bytes back to beginning of buffer */
+	/* These bytes are then later combined with subsequently read TCP packet data */
+	remaining = (int)(readEnd - readCur);
+	for (i = 0; i < remaining; i++) 
+	{
+		net_readBuffer[i] = readCur[i];
+	}
+	net_readCurrent = net_readBuffer + remaining;
+	return true;
+}
+
+static void MPConnection_Tick(struct ScheduledTask* task) {
+	cc_uint32 read;
 	cc_result res;
 
 	if (Server.Disconnected) return;
 	if (net_connecting) { MPConnection_TickConnect(task); return; }
 
 	/* NOTE: using a read call that is a multiple of 4096 (appears to?) improve read performance */	
-	res = Socket_Read(net_socket, net_readCurrent, 4096 * 4, &read);
+	res = Socket_Read(net_socket, net_readCurrent, NET_READ_SIZE, &read);
 	
 	if (res) {
 		/* 'no data available for non-blocking read' is an expected error */
@@ -403,39 +502,8 @@ static void MPConnection_Tick(struct ScheduledTask* task) {
 		/* TODO: Should this be checked unconditonally instead of just when read = 0 ? */
 		if (net_lastPacket + 30 < Game.Time) { MPConnection_Disconnect(); return; }
 	} else {
-		readCur        = net_readBuffer;
-		readEnd        = net_readCurrent + read;
-		net_lastPacket = Game.Time;
-
-		while (readCur < readEnd) {
-			cc_uint8 opcode = readCur[0];
-
-			/* Workaround for older D3 servers which wrote one byte too many for HackControl packets */
-			if (cpe_needD3Fix && lastOpcode == OPCODE_HACK_CONTROL && (opcode == 0x00 || opcode == 0xFF)) {
-				Platform_LogConst("Skipping invalid HackControl byte from D3 server");
-				readCur++;
-				LocalPlayer_ResetJumpVelocity(Entities.CurPlayer);
-				continue;
-			}
-
-			if (readCur + Protocol.Sizes[opcode] > readEnd) break;
-			handler = Protocol.Handlers[opcode];
-			if (!handler) { DisconnectInvalidOpcode(opcode); return; }
-
-			lastOpcode = opcode;
-			handler(readCur + 1); /* skip opcode */
-			readCur += Protocol.Sizes[opcode];
-		}
-
-		/* Protocol packets might be split up across TCP packets */
-		/* If so, copy last few unprocessed bytes back to beginning of buffer */
-		/* These bytes are then later combined with subsequently read TCP packet data */
-		remaining = (int)(readEnd - readCur);
-		for (i = 0; i < remaining; i++) 
-		{
-			net_readBuffer[i] = readCur[i];
-		}
-		net_readCurrent = net_readBuffer + remaining;
+		if (capture_active) NetCapture_Write(net_readCurrent, read);
+		if (!MPConnection_ProcessData(read)) return;
 	}
 
 	if (net_writeFailure) {
@@ -474,6 +542,11 @@ static void MPConnection_SendData(const cc_uint8* data, cc_uint32 len) {
 	}
 }
 
+static void MPConnection_Close(void) {
+	NetCapture_End();
+	Socket_Close(net_socket);
+}
+
 static void MPConnection_Init(void) {
 	Server_ResetState();
 	Server.IsSinglePlayer = false;
@@ -483,10 +556,125 @@ static void MPConnection_Init(void) {
 	Server.SendBlock    = MPConnection_SendBlock;
 	Server.SendChat     = MPConnection_SendChat;
 	Server.SendData     = MPConnection_SendData;
+	Server_Close        = MPConnection_Close;
 	net_readCurrent     = net_readBuffer;
 }
+
+
+/*########################################################################################################################*
+*---------------------------------------------------Replay connection-----------------------------------------------------*
+*#########################################################################################################################*/
+static char replayBuffer[FILENAME_SIZE];
+cc_string Net_ReplayFile = String_FromArray(replayBuffer);
+
+static struct Stream replay_file, replay_stream;
+static cc_uint8 replay_buffer[8192];
+static cc_uint64 replay_start;
+static float replay_speed;
+/* Time and length of the next record, if its header has been read */
+static cc_uint32 replay_time, replay_len;
+static cc_bool replay_hasRecord;
+
+static void ReplayConnection_Fail(const cc_string* reason) {
+	static const cc_string title = String_FromConst("Replay finished");
+	Game_Disconnect(&title, reason);
+}
+
+static void ReplayConnection_FailRead(cc_result res) {
+	cc_string msg; char msgBuffer[STRING_SIZE * 2];
+	String_InitArray(msg, msgBuffer);
+	String_Format2(&msg, "Error reading %s: %e", &Net_ReplayFile, &res);
+	ReplayConnection_Fail(&msg);
+}
+
+static void ReplayConnection_BeginConnect(void) {
+	cc_string title; char titleBuffer[STRING_SIZE];
+	cc_uint8 magic[sizeof(capture_magic)];
+	cc_result res;
+	String_InitArray(title, titleBuffer);
+
+	res = Stream_OpenFile(&replay_file, &Net_ReplayFile);
+	if (res) { ReplayConnection_FailRead(res); return; }
+	Stream_ReadonlyBuffered(&replay_stream, &replay_file, replay_buffer, sizeof(replay_buffer));
+	Server.Disconnected = false;
+
+	res = Stream_Read(&replay_stream, magic, sizeof(magic));
+	if (!res && !Mem_Equal(magic, capture_magic, sizeof(magic))) res = ERR_INVALID_ARGUMENT;
+	if (res) { ReplayConnection_FailRead(res); return; }
+
+	replay_speed     = Options_GetFloat(OPT_NET_REPLAY_SPEED, 0.01f, 100.0f, 1.0f);
+	replay_start     = Stopwatch_Measure();
+	replay_hasRecord = false;
+
+	String_Format1(&title, "Replaying %s..", &Net_ReplayFile);
+	LoadingScreen_Show(&title, &String_Empty);
+	Event_RaiseVoid(&NetEvents.Connected);
+
+	net_readCurrent = net_readBuffer;
+	net_lastPacket  = Game.Time;
+}
+
+static void ReplayConnection_Tick(struct ScheduledTask* task) {
+	static const cc_string finished = String_FromConst("End of the network capture was reached");
+	cc_uint8 header[CAPTURE_RECORD_SIZE];
+	cc_uint64 elapsed;
+	cc_result res;
+	if (Server.Disconnected) return;
+
+	elapsed = Stopwatch_ElapsedMicroseconds(replay_start, Stopwatch_Measure());
+	elapsed = (cc_uint64)(elapsed * replay_speed / 1000);
+
+	/* Process all the data that was originally received by this point in time */
+	for (;;)
+	{
+		if (!replay_hasRecord) {
+			res = Stream_Read(&replay_stream, header, sizeof(header));
+			if (res == ERR_END_OF_STREAM) { ReplayConnection_Fail(&finished); return; }
+			if (res) { ReplayConnection_FailRead(res); return; }
+
+			replay_time      = Stream_GetU32_LE(header + 0);
+			replay_len       = Stream_GetU32_LE(header + 4);
+			replay_hasRecord = true;
+			if (replay_len > NET_READ_SIZE) { ReplayConnection_FailRead(ERR_INVALID_ARGUMENT); return; }
+		}
+		if (replay_time > elapsed) break;
+
+		res = Stream_Read(&replay_stream, net_readCurrent, replay_len);
+		if (res) { ReplayConnection_FailRead(res); return; }
+
+		replay_hasRecord = false;
+		if (!MPConnection_ProcessData(replay_len)) return;
+		/* e.g. data was a kick packet */
+		if (Server.Disconnected) return;
+	}
+
+	/* Network is ticked 60 times a second. We only send position updates 20 times a second */
+	if ((ticks++ % 3) != 0) return;
+
+	TexturePack_CheckPending();
+	Protocol_Tick();
+}
+
+/* There is no server to send anything to */
+static void ReplayConnection_SendData(const cc_uint8* data, cc_uint32 len) { }
+
+static void ReplayConnection_Close(void) {
+	(void)replay_file.Close(&replay_file);
+}
+
+static void ReplayConnection_Init(void) {
+	MPConnection_Init();
+
+	Server.BeginConnect = ReplayConnection_BeginConnect;
+	Server.Tick         = ReplayConnection_Tick;
+	Server.SendData     = ReplayConnection_SendData;
+	Server_Close        = ReplayConnection_Close;
+}
 #else
-static void MPConnection_Init(void) { SPConnection_Init(); }
+cc_string Net_ReplayFile;
+
+static void MPConnection_Init(void)     { SPConnection_Init(); }
+static void ReplayConnection_Init(void) { SPConnection_Init(); }
 #endif
 
 
@@ -509,7 +697,9 @@ static void OnInit(void) {
 	String_InitArray(Server.MOTD,    motdBuffer);
 	String_InitArray(Server.AppName, appBuffer);
 
-	if (!Server.Address.length) {
+	if (Net_ReplayFile.length) {
+		ReplayConnection_Init();
+	} else if (!Server.Address.length) {
 		SPConnection_Init();
 	} else {
 		MPConnection_Init();
@@ -544,7 +734,7 @@ static void OnClose(void) {
 		Ping_Reset();
 		if (Server.Disconnected) return;
 
-		Socket_Close(net_socket);
+		Server_Close();
 		Server.Disconnected = true;
 	}
 }
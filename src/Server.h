@@ -76,6 +76,8 @@ void Server_RetrieveTexturePack(const cc_string* url);
 
 /* Path of map to automatically load in singleplayer */
 extern cc_string SP_AutoloadMap;
+/* Path of network capture to replay instead of connecting to a server */
+extern cc_string Net_ReplayFile;
 
 CC_END_HEADER
 #endif
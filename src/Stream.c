@@ -298,6 +298,19 @@ static cc_result Stream_BufferedRead(struct Stream* s, cc_uint8* data, cc_uint32
 	cc_uint32 read;
 	cc_result res;
 
+	/* Large reads go straight into the destination, avoiding an extra copy */
+	if (!s->meta.buffered.left && count >= s->meta.buffered.length) {
+		source = s->meta.buffered.source;
+		res    = source->Read(source, data, count, &read);
+		if (res) return res;
+
+		/* Buffer no longer holds the bytes just before end, so Seek must not treat them as cached */
+		s->meta.buffered.cur  = s->meta.buffered.base;
+		s->meta.buffered.end += read;
+		*modified = read;
+		return 0;
+	}
+
 	/* Refill buffer */
 	if (!s->meta.buffered.left) {
 		source               = s->meta.buffered.source; 
@@ -80,25 +80,34 @@ TextureRec Atlas1D_TexRec(TextureLoc texLoc, int uCount, int* index) {
 }
 
 
-static void Atlas1D_Load(int index, struct Bitmap* atlas1D) {
+/* Copies the tiles of the given 1D atlas out of the 2D atlas */
+static void Atlas1D_Copy(int index, struct Bitmap* atlas1D) {
 	int tileSize      = Atlas2D.TileSize;
 	int tilesPerAtlas = Atlas1D.TilesPerAtlas;
-	int y, tile = index * tilesPerAtlas;
-	int atlasX, atlasY;
+	int rowBytes      = tileSize * BITMAPCOLOR_SIZE;
+	int i, y, tile    = index * tilesPerAtlas;
+	BitmapCol* dst    = atlas1D->scan0;
+	BitmapCol* src;
 	
+	/* 1D atlas is exactly one tile wide, so each tile's rows are contiguous in it */
 	for (y = 0; y < tilesPerAtlas; y++, tile++) 
 	{
-		atlasX = Atlas2D_TileX(tile) * tileSize;
-		atlasY = Atlas2D_TileY(tile) * tileSize;
+		src = Bitmap_GetRow(&Atlas2D.Bmp, Atlas2D_TileY(tile) * tileSize) + Atlas2D_TileX(tile) * tileSize;
 
-		Bitmap_UNSAFE_CopyBlock(atlasX, atlasY, 0, y * tileSize,
-							&Atlas2D.Bmp, atlas1D, tileSize);
+		for (i = 0; i < tileSize; i++, dst += tileSize, src += Atlas2D.Bmp.width)
+		{
+			Mem_Copy(dst, src, rowBytes);
+		}
 	}
-	Gfx_RecreateTexture(&Atlas1D.TexIds[index], atlas1D, TEXTURE_FLAG_MANAGED | TEXTURE_FLAG_DYNAMIC, Gfx.Mipmaps);
 }
 
 /* TODO: always do this? */
 #ifdef CC_BUILD_LOWMEM
+static void Atlas1D_Load(int index, struct Bitmap* atlas1D) {
+	Atlas1D_Copy(index, atlas1D);
+	Gfx_RecreateTexture(&Atlas1D.TexIds[index], atlas1D, TEXTURE_FLAG_MANAGED | TEXTURE_FLAG_DYNAMIC, Gfx.Mipmaps);
+}
+
 static void Atlas1D_LoadBlock(int index) {
 	int tileSize      = Atlas2D.TileSize;
 	int tilesPerAtlas = Atlas1D.TilesPerAtlas;
@@ -127,21 +136,52 @@ void Atlas1D_Bind(int index) {
 	Gfx_BindTexture(Atlas1D.TexIds[index]);
 }
 
+/* 1D atlases are copied out of the 2D atlas in batches on the worker pool, */
+/*  with each batch then uploaded on the main thread (since that's where graphics calls must be made) */
+/* Each 1D atlas in a batch needs its own bitmap, so batches are only as large as there are threads to copy them */
+#define ATLAS1D_MAX_BATCH_SIZE 8
+struct Atlas1DBatch { int first; struct Bitmap* bmps; };
+
+static void Atlas1D_CopyJob(int index, void* obj) {
+	struct Atlas1DBatch* batch = (struct Atlas1DBatch*)obj;
+	Atlas1D_Copy(batch->first + index, &batch->bmps[index]);
+}
+
 static void Atlas_Convert2DTo1D(void) {
 	int tileSize      = Atlas2D.TileSize;
 	int tilesPerAtlas = Atlas1D.TilesPerAtlas;
 	int atlasesCount  = Atlas1D.Count;
-	struct Bitmap atlas1D;
-	int i;
+	struct Bitmap atlases[ATLAS1D_MAX_BATCH_SIZE];
+	struct Atlas1DBatch batch;
+	int i, j, count, batchSize;
 
 	Platform_Log2("Loaded terrain atlas: %i bmps, %i per bmp", &atlasesCount, &tilesPerAtlas);
-	Bitmap_Allocate(&atlas1D, tileSize, tilesPerAtlas * tileSize);
+	/* worker threads plus the calling thread */
+	batchSize  = min(WorkerPool_WorkersCount() + 1, ATLAS1D_MAX_BATCH_SIZE);
+	batchSize  = min(atlasesCount, batchSize);
+	batch.bmps = atlases;
+
+	for (j = 0; j < batchSize; j++)
+	{
+		Bitmap_Allocate(&atlases[j], tileSize, tilesPerAtlas * tileSize);
+	}
 	
-	for (i = 0; i < atlasesCount; i++) 
+	for (i = 0; i < atlasesCount; i += batchSize) 
 	{
-		Atlas1D_Load(i, &atlas1D);
+		count       = min(batchSize, atlasesCount - i);
+		batch.first = i;
+		WorkerPool_Run(Atlas1D_CopyJob, &batch, count);
+
+		for (j = 0; j < count; j++)
+		{
+			Gfx_RecreateTexture(&Atlas1D.TexIds[i + j], &atlases[j], TEXTURE_FLAG_MANAGED | TEXTURE_FLAG_DYNAMIC, Gfx.Mipmaps);
+		}
+	}
+
+	for (j = 0; j < batchSize; j++)
+	{
+		Mem_Free(atlases[j].scan0);
 	}
-	Mem_Free(atlas1D.scan0);
 }
 #endif
 
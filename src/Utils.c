@@ -366,3 +366,120 @@ int EntryList_Find(struct StringsBuffer* list, const cc_string* key, char separa
 	return -1;
 }
 
+
+
+/*########################################################################################################################*
+*-------------------------------------------------------WorkerPool--------------------------------------------------------*
+*#########################################################################################################################*/
+#ifdef CC_BUILD_COOPTHREADED
+void WorkerPool_Init(void) { }
+
+void WorkerPool_Run(WorkerPool_Job job, void* obj, int count) {
+	int i;
+	for (i = 0; i < count; i++) job(i, obj);
+}
+
+int WorkerPool_WorkersCount(void) { return 0; }
+#else
+/* Maximum number of background worker threads (the calling thread also runs jobs) */
+#define WORKERS_MAX 7
+static void* workers_start[WORKERS_MAX];
+static int workers_count;
+static void* workers_done;
+static void* workers_mutex;  /* Protects the job state below */
+static void* workers_runLock; /* Ensures only one thread at a time uses the pool */
+static int workers_started;
+
+static WorkerPool_Job pool_job;
+static void* pool_obj;
+static int pool_next, pool_count, pool_active;
+
+/* Runs jobs until there are no more jobs left to claim */
+static void WorkerPool_Drain(void) {
+	int index;
+	for (;;) {
+		Mutex_Lock(workers_mutex);
+		index = pool_next++;
+		Mutex_Unlock(workers_mutex);
+
+		if (index >= pool_count) return;
+		pool_job(index, pool_obj);
+	}
+}
+
+static void WorkerPool_Loop(void) {
+	int id, active;
+	Mutex_Lock(workers_mutex);
+	id = workers_started++;
+	Mutex_Unlock(workers_mutex);
+
+	for (;;) {
+		Waitable_Wait(workers_start[id]);
+		WorkerPool_Drain();
+
+		Mutex_Lock(workers_mutex);
+		active = --pool_active;
+		Mutex_Unlock(workers_mutex);
+		/* Last worker to finish wakes up the thread waiting in WorkerPool_Run */
+		if (!active) Waitable_Signal(workers_done);
+	}
+}
+
+void WorkerPool_Init(void) {
+	void* thread;
+	int i;
+	int cores;
+	if (workers_runLock) return;
+
+	/* When the number of cores is unknown, assume a single core rather than */
+	/*  paying for extra thread stacks and context switches that may not help */
+	cores = Thread_CoreCount();
+	workers_count = cores ? cores - 1 : 0;
+	if (workers_count > WORKERS_MAX) workers_count = WORKERS_MAX;
+
+	workers_runLock = Mutex_Create("Worker pool run");
+	/* Single core systems just run all jobs on the calling thread */
+	if (!workers_count) return;
+
+	workers_mutex = Mutex_Create("Worker pool jobs");
+	workers_done  = Waitable_Create("Worker pool done");
+
+	for (i = 0; i < workers_count; i++) {
+		workers_start[i] = Waitable_Create("Worker pool start");
+		Thread_Run(&thread, WorkerPool_Loop, 128 * 1024, "Worker");
+		Thread_Detach(thread);
+	}
+}
+
+void WorkerPool_Run(WorkerPool_Job job, void* obj, int count) {
+	int i;
+	WorkerPool_Init();
+
+	if (count <= 1 || !workers_count) {
+		for (i = 0; i < count; i++) job(i, obj);
+		return;
+	}
+	Mutex_Lock(workers_runLock);
+
+	Mutex_Lock(workers_mutex);
+	pool_job    = job;
+	pool_obj    = obj;
+	pool_next   = 0;
+	pool_count  = count;
+	pool_active = workers_count;
+	Mutex_Unlock(workers_mutex);
+
+	for (i = 0; i < workers_count; i++) {
+		Waitable_Signal(workers_start[i]);
+	}
+	WorkerPool_Drain();
+	Waitable_Wait(workers_done);
+
+	Mutex_Unlock(workers_runLock);
+}
+
+int WorkerPool_WorkersCount(void) {
+	WorkerPool_Init();
+	return workers_count;
+}
+#endif
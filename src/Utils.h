@@ -77,5 +77,19 @@ CC_NOINLINE STRING_REF cc_string EntryList_UNSAFE_Get(struct StringsBuffer* list
 /* Finds the index of the entry whose key caselessly equals the given key. */
 CC_NOINLINE int EntryList_Find(struct StringsBuffer* list, const cc_string* key, char separator);
 
+/* Callback invoked by a worker pool for each job. (index ranges from 0 to count - 1) */
+typedef void (*WorkerPool_Job)(int index, void* obj);
+/* Starts the background worker threads, if they haven't been started already. */
+/* NOTE: Must be called from the main thread before WorkerPool_Run is used on any other thread. */
+void WorkerPool_Init(void);
+/* Runs the given job callback once for each index from 0 to count - 1. */
+/* Jobs are spread across background worker threads, with the calling thread also running jobs. */
+/* NOTE: Blocks until all jobs have completed. Jobs may run in any order and on any thread. */
+/* NOTE: On systems without preemptive threading, or with a single or unknown number of CPU cores, */
+/*  simply runs all jobs on the calling thread. */
+void WorkerPool_Run(WorkerPool_Job job, void* obj, int count);
+/* Returns the number of background worker threads. (0 when all jobs run on the calling thread) */
+int WorkerPool_WorkersCount(void);
+
 CC_END_HEADER
 #endif
@@ -248,21 +248,27 @@ static float float32_unpack(struct VorbisState* ctx) {
 *#########################################################################################################################*/
 /* Vorbis spec 3. Probability Model and Codebooks */
 #define CODEBOOK_SYNC 0x564342
+/* Codewords up to this many bits long are decoded using a single table lookup */
+#define CODEBOOK_FAST_BITS 8
+#define CODEBOOK_FAST_SIZE (1 << CODEBOOK_FAST_BITS)
+#define CODEBOOK_FAST_MASK (CODEBOOK_FAST_SIZE - 1)
 
 struct Codebook {
 	cc_uint32 dimensions, entries, totalCodewords;
 	cc_uint32* codewords;
 	cc_uint32* values;
+	cc_uint32* fastTable; /* (value << 5) | codeword length, or 0 if not a short codeword */
 	cc_uint32 numCodewords[33]; /* number of codewords of bit length i */
 	/* vector quantisation values */
 	float minValue, deltaValue;
 	cc_uint32 sequenceP, lookupType, lookupValues;
-	cc_uint16* multiplicands;
+	float* multiplicands; /* already scaled by deltaValue and offset by minValue */
 };
 
 static void Codebook_Free(struct Codebook* c) {
 	Mem_Free(c->codewords);
 	Mem_Free(c->values);
+	Mem_Free(c->fastTable);
 	Mem_Free(c->multiplicands);
 }
 
@@ -357,6 +363,44 @@ static cc_bool Codebook_CalcCodewords(struct Codebook* c, cc_uint8* len) {
 	return true;
 }
 
+/* Reverses the lowest 'bits' bits of the given value */
+static cc_uint32 Codebook_ReverseBits(cc_uint32 value, int bits) {
+	cc_uint32 reversed = 0;
+	int i;
+
+	for (i = 0; i < bits; i++, value >>= 1)
+	{
+		reversed = (reversed << 1) | (value & 1);
+	}
+	return reversed;
+}
+
+static void Codebook_CalcFastTable(struct Codebook* c) {
+	cc_uint32* codewords = c->codewords;
+	cc_uint32* values    = c->values;
+	cc_uint32 i, j, depth, idx;
+
+	c->fastTable = (cc_uint32*)Mem_AllocCleared(CODEBOOK_FAST_SIZE, 4, "codebook fast table");
+	for (depth = 1; depth <= CODEBOOK_FAST_BITS; depth++)
+	{
+		for (i = 0; i < c->numCodewords[depth]; i++)
+		{
+			/* Bits are read LSB first, but codewords are stored MSB first */
+			idx = Codebook_ReverseBits(codewords[i] >> (32 - depth), depth);
+
+			/* Any bits after the codeword can be anything */
+			/* Earlier/shorter codewords win, same as Codebook_DecodeScalar's slow path */
+			for (j = idx; j < CODEBOOK_FAST_SIZE; j += 1 << depth)
+			{
+				if (!c->fastTable[j]) c->fastTable[j] = (values[i] << 5) | depth;
+			}
+		}
+
+		codewords += c->numCodewords[depth];
+		values    += c->numCodewords[depth];
+	}
+}
+
 static cc_result Codebook_DecodeSetup(struct VorbisState* ctx, struct Codebook* c) {
 	cc_uint32 sync;
 	cc_uint8* codewordLens;
@@ -411,6 +455,7 @@ static cc_result Codebook_DecodeSetup(struct VorbisState* ctx, struct Codebook*
 
 	c->totalCodewords = entry;
 	Codebook_CalcCodewords(c, codewordLens);
+	Codebook_CalcFastTable(c);
 	Mem_Free(codewordLens);
 
 	c->lookupType    = Vorbis_ReadBits(ctx, 4);
@@ -430,20 +475,41 @@ static cc_result Codebook_DecodeSetup(struct VorbisState* ctx, struct Codebook*
 	}
 	c->lookupValues = lookupValues;
 
-	c->multiplicands = (cc_uint16*)Mem_Alloc(lookupValues, 2, "multiplicands");
+	c->multiplicands = (float*)Mem_Alloc(lookupValues, 4, "multiplicands");
 	for (i = 0; i < lookupValues; i++) 
 	{
-		c->multiplicands[i] = Vorbis_ReadBits(ctx, valueBits);
+		c->multiplicands[i] = Vorbis_ReadBits(ctx, valueBits) * c->deltaValue + c->minValue;
 	}
 	return 0;
 }
 
+/* Returns the next CODEBOOK_FAST_BITS bits without consuming them, or -1 if the current packet has fewer bits left */
+static int Codebook_PeekFast(struct VorbisState* ctx) {
+	struct OggState* ogg = ctx->source;
+	cc_uint32 bits = ctx->Bits, numBits = ctx->NumBits, i;
+
+	/* Only peek at bytes in the current packet, as the next packet's bytes must not end up in the bit buffer */
+	for (i = 0; numBits < CODEBOOK_FAST_BITS; i++, numBits += 8)
+	{
+		if (i >= ogg->left) return -1;
+		bits |= (cc_uint32)ogg->cur[i] << numBits;
+	}
+	return bits & CODEBOOK_FAST_MASK;
+}
+
 static cc_uint32 Codebook_DecodeScalar(struct VorbisState* ctx, struct Codebook* c) {
 	cc_uint32 codeword = 0, shift = 31, depth, i;
 	cc_uint32* codewords = c->codewords;
 	cc_uint32* values    = c->values;
+	int peeked = Codebook_PeekFast(ctx);
+	cc_uint32 entry;
 
-	/* TODO: This is so massively slow */
+	if (peeked >= 0 && (entry = c->fastTable[peeked])) {
+		Vorbis_ReadBits(ctx, entry & 0x1F);
+		return entry >> 5;
+	}
+
+	/* Slow path for long codewords, or at the end of a packet */
 	for (depth = 1; depth <= 32; depth++, shift--) 
 	{
 		codeword |= Vorbis_ReadBit(ctx) << shift;
@@ -466,22 +532,22 @@ static void Codebook_DecodeVectors(struct VorbisState* ctx, struct Codebook* c,
 	float last = 0.0f, value;
 	cc_uint32 i, offset;
 
-	if (c->lookupType == 1) {		
-		cc_uint32 indexDivisor = 1;
+	if (c->lookupType == 1) {
+		/* (lookupOffset / lookupValues^i) % lookupValues, without the repeated divisor multiply */
 		for (i = 0; i < c->dimensions; i++, v += step) 
 		{
-			offset = (lookupOffset / indexDivisor) % c->lookupValues;
-			value  = c->multiplicands[offset] * c->deltaValue + c->minValue + last;
+			offset = lookupOffset % c->lookupValues;
+			value  = c->multiplicands[offset] + last;
 
 			*v += value;
 			if (c->sequenceP) last = value;
-			indexDivisor *= c->lookupValues;
+			lookupOffset /= c->lookupValues;
 		}
 	} else if (c->lookupType == 2) {
 		offset = lookupOffset * c->dimensions;
 		for (i = 0; i < c->dimensions; i++, offset++, v += step) 
 		{
-			value  = c->multiplicands[offset] * c->deltaValue + c->minValue + last;
+			value  = c->multiplicands[offset] + last;
 
 			*v += value;
 			if (c->sequenceP) last = value;
@@ -506,6 +572,8 @@ struct Floor {
 	cc_int16 subclassBooks[FLOOR_MAX_CLASSES][8];
 	cc_int16  xList[FLOOR_MAX_VALUES];
 	cc_uint16 listOrder[FLOOR_MAX_VALUES];
+	cc_uint16 loNeighbor[FLOOR_MAX_VALUES]; /* low_neighbor of each X, which only depends on setup data */
+	cc_uint16 hiNeighbor[FLOOR_MAX_VALUES]; /* high_neighbor of each X, which only depends on setup data */
 	cc_int32  yList[VORBIS_MAX_CHANS][FLOOR_MAX_VALUES];
 };
 
@@ -567,6 +635,26 @@ static void Floor_SortXList(int left, int right) {
 	}
 }
 
+/* Vorbis spec 9.2.4. low_neighbor */
+static int low_neighbor(cc_int16* v, int x) {
+	int n = 0, i, max = Int32_MinValue;
+	for (i = 0; i < x; i++) 
+	{
+		if (v[i] < v[x] && v[i] > max) { n = i; max = v[i]; }
+	}
+	return n;
+}
+
+/* Vorbis spec 9.2.5. high_neighbor */
+static int high_neighbor(cc_int16* v, int x) {
+	int n = 0, i, min = Int32_MaxValue;
+	for (i = 0; i < x; i++) 
+	{
+		if (v[i] > v[x] && v[i] < min) { n = i; min = v[i]; }
+	}
+	return n;
+}
+
 static cc_result Floor_DecodeSetup(struct VorbisState* ctx, struct Floor* f) {
 	static const short ranges[4] = { 256, 128, 84, 64 };
 	int i, j, idx, maxClass;
@@ -619,6 +707,12 @@ static cc_result Floor_DecodeSetup(struct VorbisState* ctx, struct Floor* f) {
 	tmp_xlist = xlist_sorted; 
 	tmp_order = f->listOrder;
 	Floor_SortXList(0, idx - 1);
+
+	for (i = 2; i < idx; i++)
+	{
+		f->loNeighbor[i] = low_neighbor(f->xList,  i);
+		f->hiNeighbor[i] = high_neighbor(f->xList, i);
+	}
 	return 0;
 }
 
@@ -708,26 +802,6 @@ static void Floor_RenderLine(int x0, int y0, int x1, int y1, float* data) {
 	}
 }
 
-/* Vorbis spec 9.2.4. low_neighbor */
-static int low_neighbor(cc_int16* v, int x) {
-	int n = 0, i, max = Int32_MinValue;
-	for (i = 0; i < x; i++) 
-	{
-		if (v[i] < v[x] && v[i] > max) { n = i; max = v[i]; }
-	}
-	return n;
-}
-
-/* Vorbis spec 9.2.5. high_neighbor */
-static int high_neighbor(cc_int16* v, int x) {
-	int n = 0, i, min = Int32_MaxValue;
-	for (i = 0; i < x; i++) 
-	{
-		if (v[i] > v[x] && v[i] < min) { n = i; min = v[i]; }
-	}
-	return n;
-}
-
 static void Floor_Synthesis(struct VorbisState* ctx, struct Floor* f, int ch) {
 	/* amplitude arrays */
 	cc_int32 YFinal[FLOOR_MAX_VALUES];
@@ -754,8 +828,8 @@ static void Floor_Synthesis(struct VorbisState* ctx, struct Floor* f, int ch) {
 
 	for (i = 2; i < f->values; i++) 
 	{
-		lo_offset = low_neighbor(f->xList, i);
-		hi_offset = high_neighbor(f->xList, i);
+		lo_offset = f->loNeighbor[i];
+		hi_offset = f->hiNeighbor[i];
 		predicted = Floor_RenderPoint(f->xList[lo_offset], YFinal[lo_offset],
 									  f->xList[hi_offset], YFinal[hi_offset], f->xList[i]);
 
@@ -1108,6 +1182,7 @@ void imdct_calc(float* in, float* out, struct imdct_state* state) {
 
 	float u[VORBIS_MAX_BLOCK_SIZE / 2];
 	float w[VORBIS_MAX_BLOCK_SIZE / 2];
+	float *src, *dst, *tmp;
 	float e_1, e_2, f_1, f_2;
 	float g_1, g_2, h_1, h_2;
 	float x_1, x_2, y_1, y_2;
@@ -1132,42 +1207,46 @@ void imdct_calc(float* in, float* out, struct imdct_state* state) {
 	}
 
 	/* step 3 */
+	/* each pass rewrites every element, so just ping-pong between u and w */
+	/*  instead of copying the whole intermediate array back after each pass */
 	log2_n = state->log2_n;
+	src = w; dst = u;
 	for (l = 0; l <= log2_n - 4; l++) 
 	{
 		int k0 = n >> (l+3), k1 = 1 << (l+3);
 		int r, r2, rMax = n >> (l+4), s2, s2Max = 1 << (l+2);
+		float a_1, a_2;
+		float *src0, *src1, *dst0, *dst1;
 
 		for (r = 0, r2 = 0; r < rMax; r++, r2 += 2) 
 		{
+			a_1 = A[r*k1]; a_2 = A[r*k1+1];
+
 			for (s2 = 0; s2 < s2Max; s2 += 2) 
 			{
-				e_1 = w[n2-1-k0*s2-r2];     
-				e_2 = w[n2-2-k0*s2-r2];
-				f_1 = w[n2-1-k0*(s2+1)-r2]; 
-				f_2 = w[n2-2-k0*(s2+1)-r2];
-
-				u[n2-1-k0*s2-r2]     = e_1 + f_1;
-				u[n2-2-k0*s2-r2]     = e_2 + f_2;
-				u[n2-1-k0*(s2+1)-r2] = (e_1 - f_1) * A[r*k1] - (e_2 - f_2) * A[r*k1+1];
-				u[n2-2-k0*(s2+1)-r2] = (e_2 - f_2) * A[r*k1] + (e_1 - f_1) * A[r*k1+1];
-			}
-		}
+				src0 = src + (n2-2-k0*s2-r2);     dst0 = dst + (n2-2-k0*s2-r2);
+				src1 = src + (n2-2-k0*(s2+1)-r2); dst1 = dst + (n2-2-k0*(s2+1)-r2);
 
-		/* TODO: eliminate this, do w/u in-place */
-		/* TODO: dynamically allocate mem for imdct */
-		if (l+1 <= log2_n - 4) {
-			Mem_Copy(w, u, n2 * sizeof(float));
+				e_1 = src0[1]; e_2 = src0[0];
+				f_1 = src1[1]; f_2 = src1[0];
+
+				dst0[1] = e_1 + f_1;
+				dst0[0] = e_2 + f_2;
+				dst1[1] = (e_1 - f_1) * a_1 - (e_2 - f_2) * a_2;
+				dst1[0] = (e_2 - f_2) * a_1 + (e_1 - f_1) * a_2;
+			}
 		}
+		tmp = src; src = dst; dst = tmp;
 	}
 
 	/* step 4, step 5, step 6, step 7, step 8, output */
+	/* (output of the last step 3 pass is in src after the final swap) */
 	reversed = state->reversed;
 	for (k = 0, k2 = 0; k < n8; k++, k2 += 2) 
 	{
 		cc_uint32 j = reversed[k], j4 = j << 2;
-		e_1 = u[n2-j4-1]; e_2 = u[n2-j4-2];
-		f_1 = u[j4+1];    f_2 = u[j4+0];
+		e_1 = src[n2-j4-1]; e_2 = src[n2-j4-2];
+		f_1 = src[j4+1];    f_2 = src[j4+0];
 
 		g_1 =  e_1 + f_1 + C[k2+1] * (e_1 - f_1) + C[k2] * (e_2 + f_2);
 		h_1 =  e_1 + f_1 - C[k2+1] * (e_1 - f_1) - C[k2] * (e_2 + f_2);
@@ -1585,6 +1664,38 @@ cc_result Vorbis_DecodeFrame(struct VorbisState* ctx) {
 	return 0;
 }
 
+/* Converts samples from each channel to interleaved 16 bit PCM */
+static void Vorbis_WriteSamples(cc_int16* data, float** src, int channels, int count) {
+	float sample;
+	int i, ch;
+
+	/* stereo is by far the most common, so avoid the inner channel loop there */
+	if (channels == 2) {
+		float* l = src[0];
+		float* r = src[1];
+
+		for (i = 0; i < count; i++, data += 2) 
+		{
+			sample = l[i]; Math_Clamp(sample, -1.0f, 1.0f);
+			data[0] = (cc_int16)(sample * 32767);
+			sample = r[i]; Math_Clamp(sample, -1.0f, 1.0f);
+			data[1] = (cc_int16)(sample * 32767);
+		}
+		return;
+	}
+
+	for (ch = 0; ch < channels; ch++) 
+	{
+		float* s = src[ch];
+
+		for (i = 0; i < count; i++) 
+		{
+			sample = s[i]; Math_Clamp(sample, -1.0f, 1.0f);
+			data[i * channels + ch] = (cc_int16)(sample * 32767);
+		}
+	}
+}
+
 int Vorbis_OutputFrame(struct VorbisState* ctx, cc_int16* data) {
 	struct VorbisWindow window;
 	float* prev[VORBIS_MAX_CHANS];
@@ -1592,7 +1703,7 @@ int Vorbis_OutputFrame(struct VorbisState* ctx, cc_int16* data) {
 
 	int curQrtr, prevQrtr, overlapQtr;
 	int curOffset, prevOffset, overlapSize;
-	float sample;
+	float *p, *c, *wPrev, *wCur;
 	int i, ch;
 
 	/* first frame decoded has no data */
@@ -1626,15 +1737,8 @@ int Vorbis_OutputFrame(struct VorbisState* ctx, cc_int16* data) {
 	}
 
 	/* for long prev and short cur block, there will be non-overlapped data before */
-	for (i = 0; i < prevOffset; i++) 
-	{
-		for (ch = 0; ch < ctx->channels; ch++) 
-		{
-			sample = prev[ch][i];
-			Math_Clamp(sample, -1.0f, 1.0f);
-			*data++ = (cc_int16)(sample * 32767);
-		}
-	}
+	Vorbis_WriteSamples(data, prev, ctx->channels, prevOffset);
+	data += prevOffset * ctx->channels;
 
 	/* adjust pointers to start at 0 for overlapping */
 	for (i = 0; i < ctx->channels; i++) 
@@ -1645,29 +1749,27 @@ int Vorbis_OutputFrame(struct VorbisState* ctx, cc_int16* data) {
 	overlapSize = overlapQtr * 2;
 	window = ctx->windows[(overlapQtr * 4) == ctx->blockSizes[1]];
 
-	/* overlap and add data */
-	/* also perform windowing here */
-	for (i = 0; i < overlapSize; i++) 
+	/* overlap and add data, also performing windowing here */
+	/* This is done per channel in a separate pass from interleaving, which keeps */
+	/*  the inner loop a plain multiply-add over contiguous arrays. The result is */
+	/*  stored back into the first half of cur block, which isn't needed afterwards */
+	wPrev = window.Prev; wCur = window.Cur;
+	for (ch = 0; ch < ctx->channels; ch++) 
 	{
-		for (ch = 0; ch < ctx->channels; ch++) 
+		p = prev[ch]; c = cur[ch];
+
+		for (i = 0; i < overlapSize; i++) 
 		{
-			sample = prev[ch][i] * window.Prev[i] + cur[ch][i] * window.Cur[i];
-			Math_Clamp(sample, -1.0f, 1.0f);
-			*data++ = (cc_int16)(sample * 32767);
+			c[i] = p[i] * wPrev[i] + c[i] * wCur[i];
 		}
 	}
 
+	Vorbis_WriteSamples(data, cur, ctx->channels, overlapSize);
+	data += overlapSize * ctx->channels;
+
 	/* for long cur and short prev block, there will be non-overlapped data after */
 	for (i = 0; i < ctx->channels; i++) { cur[i] += overlapSize; }
-	for (i = 0; i < curOffset; i++) 
-	{
-		for (ch = 0; ch < ctx->channels; ch++) 
-		{
-			sample = cur[ch][i];
-			Math_Clamp(sample, -1.0f, 1.0f);
-			*data++ = (cc_int16)(sample * 32767);
-		}
-	}
+	Vorbis_WriteSamples(data, cur, ctx->channels, curOffset);
 
 	ctx->prevBlockSize = ctx->curBlockSize;
 	return (prevQrtr + curQrtr) * ctx->channels;
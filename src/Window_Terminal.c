@@ -7,6 +7,7 @@
 #include "Options.h"
 #include "Errors.h"
 #include "Utils.h"
+#include "Benchmark.h"
 #include <stdio.h>
 #include <signal.h>
 #include <stdlib.h>
@@ -97,7 +98,6 @@ static void HookTerminal(void) {
 	// https://stackoverflow.com/questions/37069599/cant-read-mouse-event-use-readconsoleinput-in-c
 	SetConsoleMode(hStdin,  ENABLE_EXTENDED_FLAGS | ENABLE_WINDOW_INPUT | ENABLE_MOUSE_INPUT | ENABLE_PROCESSED_INPUT);
 	SetConsoleMode(hStdout, ENABLE_VIRTUAL_TERMINAL_PROCESSING | ENABLE_PROCESSED_OUTPUT);
-	supportsTruecolor = true;
 }
 
 static void UnhookTerminal(void) {
@@ -153,8 +153,6 @@ static void HookTerminal(void) {
 	OutputConst(DEC_PM_SET("1015")); // Ps = 1 0 1 5  ⇒  Enable urxvt Mouse Mode.
 	OutputConst(DEC_PM_SET("1006")); // Ps = 1 0 0 6  ⇒  Enable SGR Mouse Mode, xterm.
 	OutputConst(DEC_PM_RESET("25")); // Ps = 2 5  ⇒  Show cursor (DECTCEM), VT220.
-
-	supportsTruecolor = true;
 }
 
 static void UnhookTerminal(void) {
@@ -310,9 +308,9 @@ static int stdin_available(void) {
 static void UpdatePointerPosition(char* tok) {
 	int x, y;
 	tok = strtok(NULL, ";");
-	x   = atoi(tok);
+	x   = atoi(tok) - 1; // 1 based
 	tok = strtok(NULL, ";");
-	y   = atoi(tok) * CHARS_PER_CELL;
+	y   = (atoi(tok) - 1) * CHARS_PER_CELL;
 
 	SetMousePosition(x, y);
 }
@@ -414,16 +412,29 @@ void Window_Init(void) {
 	DisplayInfo.ScaleX = 0.5f;
 	DisplayInfo.ScaleY = 0.5f;
 	
+#ifdef CC_BUILD_BENCH
+	// Benchmark renders at a fixed size, without using the terminal at all
+	DisplayInfo.Width  = BENCH_WIDTH;
+	DisplayInfo.Height = BENCH_HEIGHT;
+	Window_Main.Width  = BENCH_WIDTH;
+	Window_Main.Height = BENCH_HEIGHT;
+	return;
+#endif
+
 	//ioctl(STDIN_FILENO , KDGKBMODE, &orig_KB);
 	//ioctl(STDIN_FILENO,  KDSKBMODE, K_MEDIUMRAW);
 	HookTerminal();
 	UpdateDimensions();
+	// 256 colour mode greatly reduces output size, e.g. for slow SSH connections
+	supportsTruecolor = !Options_GetBool(OPT_TERMINAL_256COLOR, false);
 	HookSignals();
 	Platform_Flags |= PLAT_FLAG_SINGLE_PROCESS;
 }
 
 void Window_Free(void) {
+#ifndef CC_BUILD_BENCH
 	UnhookTerminal();
+#endif
 }
 
 static void DoCreateWindow(int width, int height) {
@@ -487,7 +498,9 @@ void Window_ProcessEvents(float delta) {
 		return;
 	}
 	
+#ifndef CC_BUILD_BENCH
 	ProcessConsoleEvents(delta);
+#endif
 }
 
 void Gamepads_Init(void) {
@@ -531,16 +544,6 @@ cc_result Window_SaveFileDialog(const struct SaveFileDialogArgs* args) {
 }
 
 
-void Window_AllocFramebuffer(struct Bitmap* bmp, int width, int height) {
-	bmp->scan0  = (BitmapCol*)Mem_Alloc(width * height, BITMAPCOLOR_SIZE, "window pixels");
-	bmp->width  = width;
-	bmp->height = height;
-}
-
-void Window_FreeFramebuffer(struct Bitmap* bmp) {
-	Mem_Free(bmp->scan0);
-}
-
 void OnscreenKeyboard_Open(struct OpenKeyboardArgs* args) { }
 void OnscreenKeyboard_SetText(const cc_string* text) { }
 void OnscreenKeyboard_Close(void) { }
@@ -559,96 +562,169 @@ void Window_DisableRawMouse(void) {
 
 
 /*########################################################################################################################*
-*-------------------------------------------------------Console output-----------------------------------------------------*
+*-------------------------------------------------------Framebuffer-------------------------------------------------------*
 *#########################################################################################################################*/
-// TODO still wrong
-static void AppendByteFast(cc_string* str, int value) {
-	if (value >= 100) { 
-		String_Append(str, '0' + (value / 100)); value %= 100;
-		String_Append(str, '0' + (value /  10)); value %=  10;
-	} else if (value >=  10) { 
-		String_Append(str, '0' + (value /  10)); value %=  10; 
+// Colours of each character cell, as last output to the terminal
+//  (only cells whose colours have changed since then are output again)
+struct TermCell { cc_uint32 bg, fg; };
+#define TERMCELL_UNKNOWN 0xFFFFFFFFU
+// Upper bound on output for a single cell (cursor move, background and foreground colours, box character)
+#define TERMCELL_MAX_BYTES 64
+
+static struct TermCell* fb_cells;
+static char* fb_output;
+static int fb_cols, fb_rows;
+
+void Window_AllocFramebuffer(struct Bitmap* bmp, int width, int height) {
+	int i;
+	bmp->scan0  = (BitmapCol*)Mem_Alloc(width * height, BITMAPCOLOR_SIZE, "window pixels");
+	bmp->width  = width;
+	bmp->height = height;
+
+	fb_cols   = width;
+	fb_rows   = (height + CHARS_PER_CELL - 1) / CHARS_PER_CELL;
+	fb_cells  = (struct TermCell*)Mem_Alloc(fb_cols * fb_rows, sizeof(struct TermCell), "window cells");
+	fb_output = (char*)Mem_Alloc(fb_cols * fb_rows, TERMCELL_MAX_BYTES, "window output");
+
+	// Terminal contents are unknown (e.g. after a resize), so every cell must be output again
+	for (i = 0; i < fb_cols * fb_rows; i++)
+	{
+		fb_cells[i].bg = TERMCELL_UNKNOWN;
+		fb_cells[i].fg = TERMCELL_UNKNOWN;
 	}
-	String_Append(str, '0' + value);
 }
 
+void Window_FreeFramebuffer(struct Bitmap* bmp) {
+	Mem_Free(bmp->scan0);
+	Mem_Free(fb_cells);
+	Mem_Free(fb_output);
+	fb_cells  = NULL;
+	fb_output = NULL;
+}
+
+static char* AppendConst(char* dst, const char* src) {
+	while (*src) { *dst++ = *src++; }
+	return dst;
+}
+
+static char* AppendNum(char* dst, int value) {
+	char digits[10];
+	int i = 0;
+
+	do {
+		digits[i++] = '0' + (value % 10); value /= 10;
+	} while (value);
+
+	while (i) { *dst++ = digits[--i]; }
+	return dst;
+}
+
+// xterm colour cube levels are 0x00, 0x5F, 0x87, 0xAF, 0xD7, 0xFF
 static int Index256(int value) {
-	if (value <= 0x5F) return value;
-	// Add 20 to round to nearest
-	return (value - 0x5F + 20) / 40;
+	if (value <  48) return 0;
+	if (value < 115) return 1;
+	// Round to nearest of the evenly spaced upper levels
+	return (value - 35) / 40;
 }
 
-static int CalcIndex(BitmapCol rgb) {
-	int r = Index256(BitmapCol_R(rgb));
-	int g = Index256(BitmapCol_G(rgb));
-	int b = Index256(BitmapCol_B(rgb));
+static cc_uint32 EncodeColor(BitmapCol col) {
+	int r = BitmapCol_R(col), g = BitmapCol_G(col), b = BitmapCol_B(col);
+	if (supportsTruecolor) return r | (g << 8) | (b << 16);
 
-	return 16 + 36 * r + 6 * g + b;
+	return 16 + 36 * Index256(r) + 6 * Index256(g) + Index256(b);
+}
+
+// https://en.wikipedia.org/wiki/ANSI_escape_code#Colors
+static char* AppendColor(char* dst, const char* cmd, cc_uint32 col) {
+	dst = AppendConst(dst, cmd);
+
+	if (supportsTruecolor) {
+		dst = AppendConst(dst, SEP_STR "2" SEP_STR);
+		dst = AppendNum(dst, (col >>  0) & 0xFF); *dst++ = SEP_CHAR;
+		dst = AppendNum(dst, (col >>  8) & 0xFF); *dst++ = SEP_CHAR;
+		dst = AppendNum(dst, (col >> 16) & 0xFF);
+	} else {
+		dst = AppendConst(dst, SEP_STR "5" SEP_STR);
+		dst = AppendNum(dst, col);
+	}
+
+	*dst++ = 'm';
+	return dst;
+}
+
+static char* MoveCursor(char* dst, int x, int y, int curX, int curY) {
+	dst = AppendConst(dst, CSI);
+
+	// Moving forward along the same row is shorter than moving to an absolute position
+	if (y == curY && x > curX && curX >= 0) {
+		dst = AppendNum(dst, x - curX);
+		*dst++ = 'C';
+	} else {
+		dst = AppendNum(dst, y + 1); *dst++ = ';';
+		dst = AppendNum(dst, x + 1); *dst++ = 'H';
+	}
+	return dst;
+}
+
+static void OutputFrame(const char* buf, int len) {
+#ifdef CC_BUILD_WIN
+	OutputConsole(buf, len);
+#else
+	int written;
+	while (len > 0)
+	{
+		written = write(STDOUT_FILENO, buf, len);
+		if (written <= 0) return;
+
+		buf += written; len -= written;
+	}
+#endif
 }
 
 void Window_DrawFramebuffer(Rect2D r, struct Bitmap* bmp) {
-	char buf[256];
-	cc_string str;
-	int len;
-	String_InitArray(str, buf);
+	cc_uint32 curBg = TERMCELL_UNKNOWN, curFg = TERMCELL_UNKNOWN;
+	int curX = -1, curY = -1;
+	struct TermCell* cell;
+	cc_uint32 bg, fg;
+	int x, y, row, maxX, maxRow;
+	char* dst = fb_output;
+#ifdef CC_BUILD_BENCH
+	// Benchmark measures rendering, not how quickly frames can be output to a terminal
+	return;
+#endif
+
+	maxX   = r.x + r.width;
+	maxRow = (r.y + r.height + CHARS_PER_CELL - 1) / CHARS_PER_CELL;
+	if (maxX   > fb_cols) maxX   = fb_cols;
+	if (maxRow > fb_rows) maxRow = fb_rows;
 	
-	for (int y = r.y & ~0x01; y < r.y + r.height; y += 2)
+	for (row = r.y / CHARS_PER_CELL; row < maxRow; row++)
 	{
-		//len = sprintf(buf, CSI "%i;%iH", y / 2, r.x); // move cursor to start
-		//OutputConsole(buf, len);
-		str.length = 0;
-		String_AppendConst(&str, CSI);
-		String_AppendInt(  &str, y / CHARS_PER_CELL);
-		String_Append(     &str, ';');
-		String_AppendInt(  &str, r.x);
-		String_Append(     &str, 'H');
-		OutputConsole(buf, str.length);
-		
-		for (int x = r.x; x < r.x + r.width; x++)
+		y    = row * CHARS_PER_CELL;
+		cell = &fb_cells[row * fb_cols];
+
+		for (x = r.x; x < maxX; x++)
 		{
-			BitmapCol top = Bitmap_GetPixel(bmp, x, y + 0);
-			BitmapCol bot = Bitmap_GetPixel(bmp, x, y + 1);
-	
 			// Use '▄' so each cell can use a background and foreground colour
 			// This essentially doubles the vertical resolution of the displayed image
-			//printf(CSI "48;2;%i;%i;%im", BitmapCol_R(top), BitmapCol_G(top), BitmapCol_B(top));
-			//printf(CSI "38;2;%i;%i;%im", BitmapCol_R(bot), BitmapCol_G(bot), BitmapCol_B(bot));
-			//printf("\xE2\x96\x84");
-			//len = sprintf(buf, CSI "48;2;%i;%i;%im" CSI "38;2;%i;%i;%im" BOX_CHAR, 
-			//				BitmapCol_R(top), BitmapCol_G(top), BitmapCol_B(top),
-			//				BitmapCol_R(bot), BitmapCol_G(bot), BitmapCol_B(bot));
-			
-			// https://en.wikipedia.org/wiki/ANSI_escape_code#Colors
-			str.length = 0;
-			if (supportsTruecolor) {
-				String_AppendConst(&str, CSI "48" SEP_STR "2" SEP_STR);
-				String_AppendInt(  &str, BitmapCol_R(top));
-				String_Append(     &str, SEP_CHAR);
-				String_AppendInt(  &str, BitmapCol_G(top));
-				String_Append(     &str, SEP_CHAR);
-				String_AppendInt(  &str, BitmapCol_B(top));
-				String_Append(     &str, 'm');
-				
-				String_AppendConst(&str, CSI "38" SEP_STR "2" SEP_STR);
-				String_AppendInt(  &str, BitmapCol_R(bot));
-				String_Append(     &str, SEP_CHAR);
-				String_AppendInt(  &str, BitmapCol_G(bot));
-				String_Append(     &str, SEP_CHAR);
-				String_AppendInt(  &str, BitmapCol_B(bot));
-				String_Append(     &str, 'm');
-			} else {
-				String_AppendConst(&str, CSI "48" SEP_STR "5" SEP_STR);
-				String_AppendInt(  &str, CalcIndex(top));
-				String_Append(     &str, 'm');
-				
-				String_AppendConst(&str, CSI "38" SEP_STR "5" SEP_STR);
-				String_AppendInt(  &str, CalcIndex(bot));
-				String_Append(     &str, 'm');
-			}
-			
-			String_AppendConst(&str, BOX_CHAR);
-			OutputConsole(buf, str.length);
-		}		
+			bg = EncodeColor(Bitmap_GetPixel(bmp, x, y));
+			fg = y + 1 < bmp->height ? EncodeColor(Bitmap_GetPixel(bmp, x, y + 1)) : bg;
+			if (cell[x].bg == bg && cell[x].fg == fg) continue;
+
+			cell[x].bg = bg;
+			cell[x].fg = fg;
+
+			if (x != curX || row != curY) dst = MoveCursor(dst, x, row, curX, curY);
+			if (bg != curBg) dst = AppendColor(dst, CSI "48", bg);
+			if (fg != curFg) dst = AppendColor(dst, CSI "38", fg);
+			dst = AppendConst(dst, BOX_CHAR);
+
+			curBg = bg; curFg = fg;
+			// Cursor doesn't advance past the last column
+			curX  = x + 1 < fb_cols ? x + 1 : -1;
+			curY  = row;
+		}
 	}
+	OutputFrame(fb_output, (int)(dst - fb_output));
 }
 #endif
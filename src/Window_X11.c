@@ -48,6 +48,8 @@
 #include "../misc/x11/min-xinput2.h"
 #include "../misc/x11/min-XF86keysym.h"
 #include <stdio.h>
+#include <sys/ipc.h>
+#include <sys/shm.h>
 
 #ifdef X_HAVE_UTF8_STRING
 #define CC_BUILD_XIM
@@ -1220,6 +1222,121 @@ static XImage* fb_image;
 static void* fb_data;
 static int fb_fast, fb_depth;
 
+
+/*########################################################################################################################*
+*-------------------------------------------------------MIT-SHM images----------------------------------------------------*
+*#########################################################################################################################*/
+/* The MIT-SHM extension allows the X server to read the framebuffer's pixels directly from */
+/*  shared memory, rather than every pixel being copied through the X socket by XPutImage */
+typedef struct {
+	unsigned long shmseg; /* Resource ID of the segment in the X server */
+	int shmid;            /* Kernel ID of the shared memory segment */
+	char* shmaddr;        /* Address of the segment in this process */
+	Bool readOnly;        /* Whether the X server should attach the segment as read only */
+} XShmSegmentInfo;
+
+static Bool    (*_XShmQueryExtension)(Display* dpy);
+static XImage* (*_XShmCreateImage)(Display* dpy, Visual* visual, unsigned int depth, int format, char* data,
+									XShmSegmentInfo* info, unsigned int width, unsigned int height);
+static Bool    (*_XShmAttach)(Display* dpy, XShmSegmentInfo* info);
+static Bool    (*_XShmDetach)(Display* dpy, XShmSegmentInfo* info);
+static Bool    (*_XShmPutImage)(Display* dpy, Drawable d, GC gc, XImage* image, int srcX, int srcY,
+									int dstX, int dstY, unsigned int width, unsigned int height, Bool sendEvent);
+
+#if defined CC_BUILD_LINUX
+static const cc_string xextLib = String_FromConst("libXext.so.6");
+#else
+static const cc_string xextLib = String_FromConst("libXext.so");
+#endif
+static XShmSegmentInfo fb_shm;
+static cc_bool shm_checked, shm_supported, shm_attachFailed;
+
+static cc_bool XShm_IsSupported(void) {
+	static const struct DynamicLibSym funcs[] = {
+		DynamicLib_ReqSym(XShmQueryExtension), DynamicLib_ReqSym(XShmCreateImage),
+		DynamicLib_ReqSym(XShmAttach),         DynamicLib_ReqSym(XShmDetach),
+		DynamicLib_ReqSym(XShmPutImage)
+	};
+	void* lib;
+	if (shm_checked) return shm_supported;
+
+	shm_checked   = true;
+	shm_supported = DynamicLib_LoadAll(&xextLib, funcs, Array_Elems(funcs), &lib)
+						&& _XShmQueryExtension(win_display);
+
+	if (!shm_supported) Platform_LogConst("MIT-SHM unsupported, using XPutImage");
+	return shm_supported;
+}
+
+static int XShm_OnAttachError(Display* dpy, XErrorEvent* ev) {
+	shm_attachFailed = true;
+	return 0;
+}
+
+/* Attaches the shared memory segment to the X server */
+/* NOTE: Fails when the X server is on a different machine, even when it reports MIT-SHM support */
+static cc_bool XShm_Attach(void) {
+	X11_ErrorHandler prev;
+	shm_attachFailed = false;
+
+	XSync(win_display, False);
+	prev = XSetErrorHandler(XShm_OnAttachError);
+	_XShmAttach(win_display, &fb_shm);
+	XSync(win_display, False);
+	XSetErrorHandler(prev);
+
+	return !shm_attachFailed;
+}
+
+/* Attempts to create an image whose pixels are stored in a shared memory segment */
+static XImage* XShm_CreateImage(Visual* visual, int depth, int width, int height) {
+	XImage* img;
+	if (!XShm_IsSupported()) return NULL;
+
+	img = _XShmCreateImage(win_display, visual, depth, ZPixmap, NULL, &fb_shm, width, height);
+	if (!img) return NULL;
+
+	/* Pixels are drawn straight into the image in the 24/32 bit depth case */
+	if (fb_fast && img->bytes_per_line != width * BITMAPCOLOR_SIZE) { XFree(img); return NULL; }
+
+	fb_shm.shmid = shmget(IPC_PRIVATE, img->bytes_per_line * img->height, IPC_CREAT | 0600);
+	if (fb_shm.shmid == -1) { XFree(img); return NULL; }
+
+	fb_shm.shmaddr  = (char*)shmat(fb_shm.shmid, NULL, 0);
+	fb_shm.readOnly = True;
+	if (fb_shm.shmaddr == (char*)-1) fb_shm.shmaddr = NULL;
+
+	if (fb_shm.shmaddr && XShm_Attach()) {
+		/* Segment is only actually destroyed once both this process and X server detach from it */
+		shmctl(fb_shm.shmid, IPC_RMID, NULL);
+		img->data = fb_shm.shmaddr;
+		return img;
+	}
+
+	Platform_LogConst("Failed to attach MIT-SHM segment, using XPutImage");
+	shm_supported = false;
+
+	if (fb_shm.shmaddr) shmdt(fb_shm.shmaddr);
+	shmctl(fb_shm.shmid, IPC_RMID, NULL);
+	fb_shm.shmaddr = NULL;
+	XFree(img);
+	return NULL;
+}
+
+static void XShm_FreeImage(void) {
+	_XShmDetach(win_display, &fb_shm);
+	/* Make sure X server has detached before the segment is unmapped */
+	XSync(win_display, False);
+
+	XFree(fb_image);
+	shmdt(fb_shm.shmaddr);
+	fb_shm.shmaddr = NULL;
+}
+
+
+/*########################################################################################################################*
+*-------------------------------------------------------Framebuffer-------------------------------------------------------*
+*#########################################################################################################################*/
 void Window_AllocFramebuffer(struct Bitmap* bmp, int width, int height) {
 	Window win = Window_Main.Handle.val;
 	XWindowAttributes attribs = { 0 };
@@ -1228,19 +1345,26 @@ void Window_AllocFramebuffer(struct Bitmap* bmp, int width, int height) {
 	XGetWindowAttributes(win_display, win, &attribs);
 	fb_depth = attribs.depth;
 
-	bmp->scan0  = (BitmapCol*)Mem_Alloc(width * height, BITMAPCOLOR_SIZE, "window pixels");
 	bmp->width  = width;
 	bmp->height = height;
 
 	/* X11 requires that the image to draw has same depth as window */
 	/* Easy for 24/32 bit case, but much trickier with other depths */
 	/*  (have to do a manual and slow second blit for other depths) */
-	fb_fast = attribs.depth == 24 || attribs.depth == 32;
-	fb_data = fb_fast ? bmp->scan0 : Mem_Alloc(width * height, BITMAPCOLOR_SIZE, "window blit");
+	fb_fast  = attribs.depth == 24 || attribs.depth == 32;
+	fb_image = XShm_CreateImage(attribs.visual, attribs.depth, width, height);
 
-	fb_image = XCreateImage(win_display, attribs.visual,
-		attribs.depth, ZPixmap, 0, (char*)fb_data,
-		width, height, 32, 0);
+	if (fb_image) {
+		fb_data  = fb_image->data;
+	} else {
+		fb_data  = Mem_Alloc(width * height, BITMAPCOLOR_SIZE, "window blit");
+		fb_image = XCreateImage(win_display, attribs.visual,
+			attribs.depth, ZPixmap, 0, (char*)fb_data,
+			width, height, 32, 0);
+	}
+
+	bmp->scan0 = fb_fast ? (BitmapCol*)fb_data
+				: (BitmapCol*)Mem_Alloc(width * height, BITMAPCOLOR_SIZE, "window pixels");
 }
 
 static void BlitFramebuffer(int x1, int y1, int width, int height, struct Bitmap* bmp) {
@@ -1289,14 +1413,27 @@ void Window_DrawFramebuffer(Rect2D r, struct Bitmap* bmp) {
 	/* Convert 32 bit depth to window depth when required */
 	if (!fb_fast) BlitFramebuffer(r.x, r.y, r.width, r.height, bmp);
 
-	XPutImage(win_display, win, fb_gc, fb_image,
-		r.x, r.y, r.x, r.y, r.width, r.height);
+	if (fb_shm.shmaddr) {
+		_XShmPutImage(win_display, win, fb_gc, fb_image,
+			r.x, r.y, r.x, r.y, r.width, r.height, False);
+		/* Pixels are read directly from shared memory, so the X server must finish */
+		/*  reading them before the caller is allowed to start drawing the next frame */
+		XSync(win_display, False);
+	} else {
+		XPutImage(win_display, win, fb_gc, fb_image,
+			r.x, r.y, r.x, r.y, r.width, r.height);
+	}
 }
 
 void Window_FreeFramebuffer(struct Bitmap* bmp) {
-	XFree(fb_image);
-	Mem_Free(bmp->scan0);
-	if (bmp->scan0 != fb_data) Mem_Free(fb_data);
+	if (bmp->scan0 != fb_data) Mem_Free(bmp->scan0);
+
+	if (fb_shm.shmaddr) {
+		XShm_FreeImage();
+	} else {
+		XFree(fb_image);
+		Mem_Free(fb_data);
+	}
 }
 
 void OnscreenKeyboard_Open(struct OpenKeyboardArgs* args) { }
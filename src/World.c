@@ -10,6 +10,7 @@
 #include "Game.h"
 #include "TexturePack.h"
 #include "Window.h"
+#include "Funcs.h"
 
 struct _WorldData World;
 static char nameBuffer[STRING_SIZE];
@@ -37,11 +38,19 @@ static void GenerateNewUuid(void) {
 	World.Uuid[8] |= 0x80; /* variant 2*/
 }
 
+#ifdef EXTENDED_BLOCKS
+static BlockRaw* upper_pending;
+static BlockRaw** pages_pending;
+static int pages_pendingCount;
+static void FreePages(BlockRaw** pages, int count);
+static void FreeUpper(void);
+static void CompactUpper(void);
+static void UsePendingPages(void);
+#endif
+
 void World_Reset(void) {
 #ifdef EXTENDED_BLOCKS
-	if (World.Blocks != World.Blocks2) Mem_Free(World.Blocks2);
-	World.Blocks2 = NULL;
-	World.IDMask  = 0xFF;
+	FreeUpper();
 #endif
 	Mem_Free(World.Blocks);
 	World.Blocks = NULL;
@@ -69,11 +78,9 @@ void World_SetNewMap(BlockRaw* blocks, int width, int height, int length) {
 
 	if (!World.Volume) World.Blocks = NULL;
 #ifdef EXTENDED_BLOCKS
-	/* .cw maps may have set this to a non-NULL when importing */
-	if (!World.Blocks2) {
-		World.Blocks2 = World.Blocks;
-		World.IDMask  = 0xFF;
-	}
+	/* .cw maps and servers may have provided upper bits when importing */
+	if (upper_pending) CompactUpper();
+	if (pages_pending) UsePendingPages();
 #endif
 
 	if (Env.EdgeHeight == -1)   { Env.EdgeHeight   = height / 2; }
@@ -102,8 +109,15 @@ CC_NOINLINE void World_SetDimensions(int width, int height, int length) {
 
 #ifdef EXTENDED_BLOCKS
 void World_SetMapUpper(BlockRaw* blocks) {
-	World.Blocks2 = blocks;
-	World.IDMask  = 0x3FF;
+	/* map dimensions usually aren't known yet at this point */
+	Mem_Free(upper_pending);
+	upper_pending = blocks;
+}
+
+void World_SetMapUpperPages(BlockRaw** pages, int count) {
+	FreePages(pages_pending, pages_pendingCount);
+	pages_pending      = pages;
+	pages_pendingCount = count;
 }
 #endif
 
@@ -114,25 +128,87 @@ void World_OutOfMemory(void) {
 
 
 #ifdef EXTENDED_BLOCKS
-static CC_NOINLINE void LazyInitUpper(int i, BlockID block) {
-	BlockRaw* data = (BlockRaw*)Mem_TryAllocCleared(World.Volume, 1);
-	if (!data) { World_OutOfMemory(); return; }
+static void FreePages(BlockRaw** pages, int count) {
+	int i;
+	if (!pages) return;
+
+	for (i = 0; i < count; i++) Mem_Free(pages[i]);
+	Mem_Free(pages);
+}
+
+static void FreeUpper(void) {
+	FreePages(World.Blocks2Pages, (World.Volume + WORLD_UPPER_MASK) >> WORLD_UPPER_SHIFT);
+	World.Blocks2Pages = NULL;
+	World.IDMask       = 0xFF;
+
+	Mem_Free(upper_pending);
+	upper_pending = NULL;
+
+	FreePages(pages_pending, pages_pendingCount);
+	pages_pending = NULL;
+}
 
-	World_SetMapUpper(data);
-	World.Blocks2[i] = (BlockRaw)(block >> 8);
+static CC_NOINLINE BlockRaw* AllocUpperPage(int page) {
+	int count = (World.Volume + WORLD_UPPER_MASK) >> WORLD_UPPER_SHIFT;
+	BlockRaw* data;
+
+	if (!World.Blocks2Pages) {
+		World.Blocks2Pages = (BlockRaw**)Mem_TryAllocCleared(count, sizeof(BlockRaw*));
+		if (!World.Blocks2Pages) { World_OutOfMemory(); return NULL; }
+		World.IDMask = 0x3FF;
+	}
+
+	data = (BlockRaw*)Mem_TryAllocCleared(WORLD_UPPER_PAGE_SIZE, 1);
+	if (!data) { World_OutOfMemory(); return NULL; }
+
+	World.Blocks2Pages[page] = data;
+	return data;
+}
+
+/* Copies the pending full size upper array into pages, skipping pages which are all 0 */
+static void CompactUpper(void) {
+	BlockRaw* src = upper_pending;
+	BlockRaw* page;
+	int i, j, len;
+	upper_pending = NULL;
+
+	for (i = 0; i < World.Volume; i += WORLD_UPPER_PAGE_SIZE) 
+	{
+		len = min(WORLD_UPPER_PAGE_SIZE, World.Volume - i);
+		for (j = 0; j < len && !src[i + j]; j++) { }
+		if (j == len) continue;
+
+		page = AllocUpperPage(i >> WORLD_UPPER_SHIFT);
+		if (!page) break;
+		Mem_Copy(page, src + i, len);
+	}
+	Mem_Free(src);
+}
+
+static void UsePendingPages(void) {
+	int count = (World.Volume + WORLD_UPPER_MASK) >> WORLD_UPPER_SHIFT;
+
+	if (World.Volume && count == pages_pendingCount) {
+		World.Blocks2Pages = pages_pending;
+		World.IDMask       = 0x3FF;
+	} else {
+		FreePages(pages_pending, pages_pendingCount);
+	}
+	pages_pending = NULL;
 }
 
 void World_SetBlock(int x, int y, int z, BlockID block) {
 	int i = World_Pack(x, y, z);
+	BlockRaw* page;
 	World.Blocks[i] = (BlockRaw)block;
 
-	/* defer allocation of second map array if possible */
-	if (World.Blocks == World.Blocks2) {
+	page = World.Blocks2Pages ? World.Blocks2Pages[i >> WORLD_UPPER_SHIFT] : NULL;
+	if (!page) {
+		/* defer allocation of upper bits page if possible */
 		if (block < 256) return;
-		LazyInitUpper(i, block);
-		return;
+		if (!(page = AllocUpperPage(i >> WORLD_UPPER_SHIFT))) return;
 	}
-	World.Blocks2[i] = (BlockRaw)(block >> 8);
+	page[i & WORLD_UPPER_MASK] = (BlockRaw)(block >> 8);
 }
 #else
 void World_SetBlock(int x, int y, int z, BlockID block) {
@@ -25,9 +25,10 @@ CC_VAR extern struct _WorldData {
 	/* The blocks in the world. */
 	BlockRaw* Blocks;
 #ifdef EXTENDED_BLOCKS
-	/* The upper 8 bit of blocks in the world. */
-	/* If only 8 bit blocks are used, equals World_Blocks. */
-	BlockRaw* Blocks2;
+	/* The upper 8 bit of blocks in the world, split into pages of WORLD_UPPER_PAGE_SIZE blocks. */
+	/* Pages with no blocks above 255 are NULL, and this is NULL if only 8 bit blocks are used. */
+	/* NOTE: This replaced the full size Blocks2 array in plugin API version 2. */
+	BlockRaw** Blocks2Pages;
 #endif
 	/* Volume of the world. */
 	int Volume;
@@ -43,7 +44,7 @@ CC_VAR extern struct _WorldData {
 	cc_uint8 Uuid[WORLD_UUID_LEN];
 
 #ifdef EXTENDED_BLOCKS
-	/* Masks access to World.Blocks/World.Blocks2 */
+	/* Masks access to World.Blocks/World.Blocks2Pages */
 	/* e.g. this will be 255 if only 8 bit blocks are used */
 	int IDMask;
 #endif
@@ -76,10 +77,28 @@ CC_NOINLINE void World_SetDimensions(int width, int height, int length);
 void World_OutOfMemory(void);
 
 #ifdef EXTENDED_BLOCKS
-/* Sets World.Blocks2 and updates internal state for more than 256 blocks. */
-void World_SetMapUpper(BlockRaw* blocks);
+#define WORLD_UPPER_SHIFT 12
+#define WORLD_UPPER_PAGE_SIZE (1 << WORLD_UPPER_SHIFT)
+#define WORLD_UPPER_MASK (WORLD_UPPER_PAGE_SIZE - 1)
 
-#define World_GetRawBlock(idx) ((World.Blocks[idx] | (World.Blocks2[idx] << 8)) & World.IDMask)
+/* Sets the upper 8 bits of all blocks in the world, for more than 256 blocks. */
+/* NOTE: Pages are only allocated for parts of the map that use blocks above 255, */
+/*  and the given array is freed once the map has finished loading. */
+void World_SetMapUpper(BlockRaw* blocks);
+/* Sets the upper 8 bits of all blocks in the world, already split into pages. (see World.Blocks2Pages) */
+/* NOTE: Discarded if count does not match the number of pages in the map that is then loaded. */
+void World_SetMapUpperPages(BlockRaw** pages, int count);
+
+/* Gets the block at the given packed index. */
+/* NOTE: Does NOT check that the index is inside the map. */
+static CC_INLINE BlockID World_GetRawBlock(int i) {
+	BlockRaw* page;
+	if (!World.Blocks2Pages) return World.Blocks[i];
+
+	page = World.Blocks2Pages[i >> WORLD_UPPER_SHIFT];
+	if (!page) return World.Blocks[i];
+	return (World.Blocks[i] | (page[i & WORLD_UPPER_MASK] << 8)) & World.IDMask;
+}
 
 /* Gets the block at the given coordinates. */
 /* NOTE: Does NOT check that the coordinates are inside the map. */
@@ -4,6 +4,8 @@
 #include "Errors.h"
 #include "Utils.h"
 #include "Platform.h"
+#include "Funcs.h"
+#include "ExtMath.h"
 
 void Audio_Warn(cc_result res, const char* action) {
 	Logger_Warn(res, action, Audio_DescribeError);
@@ -114,12 +116,286 @@ void AudioBackend_LoadSounds(void) { Sounds_LoadDefault(); }
 *---------------------------------------------------Audio context code----------------------------------------------------*
 *#########################################################################################################################*/
 struct AudioContext music_ctx;
+
+#if defined CC_BUILD_NOSOUNDS
+/* Sounds are never played, so no mixer or context pool is needed */
+#elif defined AUDIO_SOFTWARE_MIXER
+/* All sounds are mixed together into a single stereo stream, rather than */
+/*  each sound being played on its own backend context. The mixed output */
+/*  is queued in small chunks from a dedicated mixer thread, so that long */
+/*  frames on the main thread don't cause the queued audio to run out */
+#define MIXER_MAX_VOICES   32
+#define MIXER_SAMPLE_RATE  44100
+/* 512 frames is ~11.6 ms, so at most ~46 ms of mixed audio is queued ahead */
+#define MIXER_CHUNK_FRAMES 512
+/* How often the mixer thread checks for finished chunks while sounds are playing */
+#define MIXER_POLL_MS      4
+/* Fixed point precision for gain (8.8) and playback position (16.16) */
+#define MIXER_GAIN_SHIFT   8
+#define MIXER_POS_SHIFT   16
+#define MIXER_POS_ONE     (1 << MIXER_POS_SHIFT)
+
+struct MixerVoice {
+	const cc_int16* data; /* NULL when voice is not playing anything */
+	cc_uint32 frames;     /* total number of frames in data */
+	cc_uint32 index;      /* current frame being played */
+	cc_uint32 frac, step; /* fractional position and step per output frame */
+	int channels;
+	int gainL, gainR;
+};
+
+static struct AudioContext mixer_ctx;
+static struct AudioChunk mixer_chunks[AUDIO_MAX_BUFFERS];
+static struct MixerVoice mixer_voices[MIXER_MAX_VOICES];
+static cc_int32 mixer_accum[MIXER_CHUNK_FRAMES * 2];
+static int mixer_active, mixer_next;
+static cc_bool mixer_inited;
+static void* mixer_thread;
+static void* mixer_waitable;
+static void* mixer_lock;
+static volatile cc_bool mixer_stopping;
+static volatile cc_result mixer_result;
+
+static void MixerVoice_MixMono(struct MixerVoice* v, cc_int32* dst, int count) {
+	const cc_int16* src = v->data;
+	cc_uint32 index = v->index, frac = v->frac, step = v->step;
+	int gainL = v->gainL, gainR = v->gainR;
+	int i, sample;
+
+	/* sample rate matches output, so no need to resample */
+	if (step == MIXER_POS_ONE) {
+		count = min(count, (int)(v->frames - index));
+		src  += index;
+
+		for (i = 0; i < count; i++) 
+		{
+			dst[i * 2 + 0] += src[i] * gainL;
+			dst[i * 2 + 1] += src[i] * gainR;
+		}
+		v->index = index + count; return;
+	}
+
+	for (i = 0; i < count && index < v->frames; i++) 
+	{
+		sample = src[index];
+		/* linearly interpolate towards next sample */
+		if (index + 1 < v->frames) {
+			sample += ((src[index + 1] - sample) * (int)(frac >> 1)) >> (MIXER_POS_SHIFT - 1);
+		}
+
+		dst[i * 2 + 0] += sample * gainL;
+		dst[i * 2 + 1] += sample * gainR;
+
+		frac  += step;
+		index += frac >> MIXER_POS_SHIFT;
+		frac  &= MIXER_POS_ONE - 1;
+	}
+	v->index = index; v->frac = frac;
+}
+
+static void MixerVoice_MixStereo(struct MixerVoice* v, cc_int32* dst, int count) {
+	const cc_int16* src = v->data;
+	cc_uint32 index = v->index, frac = v->frac, step = v->step;
+	int gainL = v->gainL, gainR = v->gainR;
+	int i, l, r;
+
+	for (i = 0; i < count && index < v->frames; i++) 
+	{
+		l = src[index * 2 + 0];
+		r = src[index * 2 + 1];
+		/* linearly interpolate towards next sample */
+		if (index + 1 < v->frames) {
+			l += ((src[index * 2 + 2] - l) * (int)(frac >> 1)) >> (MIXER_POS_SHIFT - 1);
+			r += ((src[index * 2 + 3] - r) * (int)(frac >> 1)) >> (MIXER_POS_SHIFT - 1);
+		}
+
+		dst[i * 2 + 0] += l * gainL;
+		dst[i * 2 + 1] += r * gainR;
+
+		frac  += step;
+		index += frac >> MIXER_POS_SHIFT;
+		frac  &= MIXER_POS_ONE - 1;
+	}
+	v->index = index; v->frac = frac;
+}
+
+/* Mixes all playing voices into the given interleaved stereo samples */
+static void AudioMixer_Mix(cc_int16* dst, int frames) {
+	struct MixerVoice* v;
+	int i, sample, active = 0;
+	Mem_Set(mixer_accum, 0, frames * 2 * sizeof(cc_int32));
+
+	for (i = 0; i < MIXER_MAX_VOICES; i++) 
+	{
+		v = &mixer_voices[i];
+		if (!v->data) continue;
+
+		if (v->channels == 1) {
+			MixerVoice_MixMono(v,   mixer_accum, frames);
+		} else {
+			MixerVoice_MixStereo(v, mixer_accum, frames);
+		}
+
+		if (v->index >= v->frames) { v->data = NULL; } else { active++; }
+	}
+
+	for (i = 0; i < frames * 2; i++) 
+	{
+		sample = mixer_accum[i] >> MIXER_GAIN_SHIFT;
+		Math_Clamp(sample, -32768, 32767);
+		dst[i] = (cc_int16)sample;
+	}
+	mixer_active = active;
+}
+
+/* Queues more mixed audio, if there are free chunks and any sounds still playing */
+/* NOTE: mixer_lock must be held when calling this */
+static cc_result AudioMixer_Update(void) {
+	struct AudioChunk* chunk;
+	int i, inUse, prevInUse = 0;
+	cc_bool wasIdle;
+	cc_result res;
+
+	/* some backends only release one finished buffer per update */
+	for (i = 0; i < AUDIO_MAX_BUFFERS; i++)
+	{
+		if ((res = StreamContext_Update(&mixer_ctx, &inUse))) return res;
+		if (i && inUse == prevInUse) break;
+		prevInUse = inUse;
+	}
+	wasIdle = inUse == 0;
+
+	while (inUse < AUDIO_MAX_BUFFERS && mixer_active) {
+		chunk = &mixer_chunks[mixer_next];
+		AudioMixer_Mix((cc_int16*)chunk->data, MIXER_CHUNK_FRAMES);
+
+		chunk->size = MIXER_CHUNK_FRAMES * 2 * sizeof(cc_int16);
+		if ((res = StreamContext_Enqueue(&mixer_ctx, chunk))) return res;
+
+		mixer_next = (mixer_next + 1) % AUDIO_MAX_BUFFERS;
+		inUse++;
+	}
+
+	/* backend stops once all queued audio has been played */
+	if (wasIdle && inUse) return StreamContext_Play(&mixer_ctx);
+	return 0;
+}
+
+static void AudioMixer_RunLoop(void) {
+	cc_result res = 0;
+	int active;
+
+	while (!mixer_stopping) {
+		Mutex_Lock(mixer_lock);
+		{
+			if (mixer_active) res = AudioMixer_Update();
+			active = mixer_active;
+		}
+		Mutex_Unlock(mixer_lock);
+
+		/* Reported on the main thread by the next AudioPool_Play call */
+		if (res) { mixer_result = res; break; }
+
+		if (active) {
+			Waitable_WaitFor(mixer_waitable, MIXER_POLL_MS);
+		} else {
+			Waitable_Wait(mixer_waitable);
+		}
+	}
+}
+
+static cc_result AudioMixer_Init(void) {
+	cc_result res;
+	if ((res = Audio_Init(&mixer_ctx, AUDIO_MAX_BUFFERS)))                      return res;
+	if ((res = StreamContext_SetFormat(&mixer_ctx, 2, MIXER_SAMPLE_RATE, 100))) return res;
+
+	res = Audio_AllocChunks(MIXER_CHUNK_FRAMES * 2 * sizeof(cc_int16), 
+							mixer_chunks, AUDIO_MAX_BUFFERS);
+	if (res) return res;
+
+	mixer_inited   = true;
+	mixer_next     = 0;
+	mixer_stopping = false;
+	mixer_result   = 0;
+
+	mixer_lock     = Mutex_Create("Audio mixer");
+	mixer_waitable = Waitable_Create("Audio mixer sleep");
+	Thread_Run(&mixer_thread, AudioMixer_RunLoop, 64 * 1024, "Audio mixer");
+	return 0;
+}
+
+cc_result AudioPool_Play(struct AudioData* data) {
+	struct MixerVoice* v = NULL;
+	cc_uint32 remaining, minRemaining = (cc_uint32)-1;
+	int i, volume, sampleRate;
+	cc_bool stolen;
+	cc_result res;
+
+	if (data->channels != 1 && data->channels != 2) return ERR_INVALID_ARGUMENT;
+	if (!mixer_inited && (res = AudioMixer_Init())) return res;
+	if (mixer_result) return mixer_result;
+
+	sampleRate = Audio_AdjustSampleRate(data->sampleRate, data->rate);
+	volume     = data->volume << MIXER_GAIN_SHIFT;
+
+	Mutex_Lock(mixer_lock);
+	{
+		/* Pick a free voice, or otherwise steal the one closest to finishing */
+		for (i = 0; i < MIXER_MAX_VOICES; i++) 
+		{
+			if (!mixer_voices[i].data) { v = &mixer_voices[i]; break; }
+
+			remaining = mixer_voices[i].frames - mixer_voices[i].index;
+			if (remaining < minRemaining) { v = &mixer_voices[i]; minRemaining = remaining; }
+		}
+
+		stolen      = v->data != NULL;
+		v->data     = (const cc_int16*)data->chunk.data;
+		v->channels = data->channels;
+		v->frames   = data->chunk.size / (2 * data->channels);
+		v->index    = 0;
+		v->frac     = 0;
+		v->step     = (cc_uint32)(((cc_uint64)sampleRate << MIXER_POS_SHIFT) / MIXER_SAMPLE_RATE);
+
+		/* simple balance, so centred sounds are still played at full volume */
+		v->gainL = volume * (100 - max(data->pan, 0)) / (100 * 100);
+		v->gainR = volume * (100 + min(data->pan, 0)) / (100 * 100);
+
+		/* Mix the new sound into any free chunks straight away */
+		if (!stolen) mixer_active++;
+		res = AudioMixer_Update();
+	}
+	Mutex_Unlock(mixer_lock);
+
+	Waitable_Signal(mixer_waitable);
+	return res;
+}
+
+void AudioPool_Close(void) {
+	if (mixer_inited) {
+		mixer_stopping = true;
+		Waitable_Signal(mixer_waitable);
+		Thread_Join(mixer_thread);
+
+		Mutex_Free(mixer_lock);
+		Waitable_Free(mixer_waitable);
+		mixer_thread = NULL;
+	}
+
+	Mem_Set(mixer_voices, 0, sizeof(mixer_voices));
+	mixer_active = 0;
+	if (!mixer_inited) return;
+
+	Audio_Close(&mixer_ctx);
+	Audio_FreeChunks(mixer_chunks, AUDIO_MAX_BUFFERS);
+	mixer_inited = false;
+}
+#else
 #ifndef POOL_MAX_CONTEXTS
 #define POOL_MAX_CONTEXTS 8
 #endif
 static struct AudioContext context_pool[POOL_MAX_CONTEXTS];
 
-#ifndef CC_BUILD_NOSOUNDS
 cc_result AudioPool_Play(struct AudioData* data) {
 	struct AudioContext* ctx;
 	cc_bool isBusy;
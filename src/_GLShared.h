@@ -64,10 +64,61 @@ static void* FastAllocTempMem(int size) {
 }
 
 
+/*########################################################################################################################*
+*-------------------------------------------------Streaming vertex buffers------------------------------------------------*
+*#########################################################################################################################*/
+#if CC_GFX_BACKEND != CC_GFX_BACKEND_GL11
+/* Rather than always overwriting from the start, each update to a dynamic vertex buffer is written */
+/*  after the previous update, and the buffer's storage is only orphaned once it has filled up. */
+/* This way the driver doesn't have to wait for draws still using the old data before updating */
+struct GLDynamicVb {
+	GfxResourceID id;
+	cc_uint32 size;   /* Size of the buffer's storage in bytes */
+	cc_uint32 cursor; /* Offset that the next update may be written at */
+	int stride;       /* Size of each vertex in bytes */
+	int base;         /* Index of first vertex of the most recent update */
+};
+/* Dynamic vertex buffers have room for (at least) this many full updates before being orphaned */
+#define DYNAMICVB_UPDATES  4
+#define DYNAMICVB_MIN_SIZE (16 * 1024)
+
+/* Index of the first vertex to draw from the currently bound vertex buffer */
+static int gfx_baseVertex;
+
+static struct GLDynamicVb* GLDynamicVb_Alloc(VertexFormat fmt, int maxVertices) {
+	struct GLDynamicVb* vb = (struct GLDynamicVb*)Mem_TryAllocCleared(1, sizeof(struct GLDynamicVb));
+	if (!vb) return NULL;
+
+	vb->stride = strideSizes[fmt];
+	vb->size   = max(maxVertices * vb->stride * DYNAMICVB_UPDATES, DYNAMICVB_MIN_SIZE);
+	return vb;
+}
+
+/* Reserves space in the buffer for an update of the given size, returning the offset to write it at */
+/* NOTE: An offset of 0 means the buffer's storage must be orphaned before writing */
+static cc_uint32 GLDynamicVb_Reserve(struct GLDynamicVb* vb, cc_uint32 size) {
+	cc_uint32 offset = vb->cursor + (vb->stride - vb->cursor % vb->stride) % vb->stride;
+
+	if (offset + size > vb->size) {
+		offset   = 0;
+		vb->size = max(vb->size, size);
+	}
+	vb->cursor = offset + size;
+	vb->base   = offset / vb->stride;
+
+	gfx_baseVertex = vb->base;
+	return offset;
+}
+#endif
+
+
 /*########################################################################################################################*
 *---------------------------------------------------------Textures--------------------------------------------------------*
 *#########################################################################################################################*/
 static cc_bool convert_rgba;
+/* Generates all the mipmap levels of the currently bound texture on the GPU */
+/* NOTE: NULL when unsupported by the backend, or not enabled by the user */
+static void (APIENTRY *_glGenerateMipmap)(GLenum target);
 
 static void ConvertRGBA(void* dst, const void* src, int numPixels) {
 	cc_uint8* d = (cc_uint8*)dst;
@@ -130,6 +181,10 @@ static void Gfx_DoMipmaps(int x, int y, struct Bitmap* bmp, int rowWidth, cc_boo
 	int lvls = CalcMipmapsLevels(bmp->width, bmp->height);
 	int lvl, width = bmp->width, height = bmp->height;
 
+	/* glGenerateMipmap regenerates the entire chain, so partial updates (e.g. animations every tick) */
+	/*  instead only regenerate the updated region of each level below */
+	if (_glGenerateMipmap && !partial) { _glGenerateMipmap(GL_TEXTURE_2D); return; }
+
 	for (lvl = 1; lvl <= lvls; lvl++) {
 		x /= 2; y /= 2;
 		if (width > 1)  width /= 2;
@@ -19,6 +19,7 @@ Eg. the webclient 'main' function loads IndexedDB, and when that has asynchronou
 #include "Server.h"
 #include "Options.h"
 #include "main.h"
+#include "Benchmark.h"
 
 /*########################################################################################################################*
 *-------------------------------------------------Complex argument parsing------------------------------------------------*
@@ -83,6 +84,14 @@ static void RunGame(void) {
 	Window_Destroy();
 }
 
+#ifdef CC_BUILD_BENCH
+static void RunBenchmark(void) {
+	static const cc_string output = String_FromConst("benchmark.json");
+	Benchmark_Run(&output);
+	Window_Destroy();
+}
+#endif
+
 static void RunLauncher(void) {
 #ifndef CC_BUILD_WEB
 	Launcher_Setup();
@@ -162,6 +171,7 @@ static int ParseMPArgs(const cc_string* user, const cc_string* mppass, const cc_
 #define ARG_RESULT_RUN_LAUNCHER 1
 #define ARG_RESULT_RUN_GAME     2
 #define ARG_RESULT_INVALID_ARGS 3
+#define ARG_RESULT_RUN_BENCH    4
 
 static int ProcessProgramArgs(int argc, char** argv) {
 cc_string args[GAME_MAX_CMDARGS];
@@ -176,6 +186,18 @@ cc_string args[GAME_MAX_CMDARGS];
 	//argsCount = String_UNSAFE_Split(&rawArgs, ' ', args, 4);
 #endif
 
+#ifdef CC_BUILD_BENCH
+	/* [map path] - run the headless benchmark on the given map (map path is required) */
+	if (argsCount == 1) {
+		Options_Get(LOPT_USERNAME, &Game_Username, DEFAULT_USERNAME);
+		String_Copy(&SP_AutoloadMap, &args[0]);
+		return ARG_RESULT_RUN_BENCH;
+	}
+
+	Platform_LogConst("Usage: ClassiCube-bench <map file>");
+	return ARG_RESULT_INVALID_ARGS;
+#endif
+
 	if (argsCount == 0)
 		return ARG_RESULT_RUN_LAUNCHER;
 
@@ -228,6 +250,15 @@ cc_string args[GAME_MAX_CMDARGS];
 		return ARG_RESULT_RUN_GAME;
 	}
 	
+#ifdef CC_BUILD_NETWORKING
+	/* --replay [capture path] - replay a network capture made using the net-capture-file option */
+	if (argsCount == 2 && String_CaselessEqualsConst(&args[0], DEFAULT_REPLAY_ARG)) {
+		Options_Get(LOPT_USERNAME, &Game_Username, DEFAULT_USERNAME);
+		String_Copy(&Net_ReplayFile, &args[1]);
+		return ARG_RESULT_RUN_GAME;
+	}
+#endif
+	
 	/* 2 to 3 arguments - unsupported at present */
 	if (argsCount < 4) {
 		WarnMissingArgs(argsCount, args);
@@ -249,6 +280,11 @@ static int RunProgram(int argc, char** argv) {
 	case ARG_RESULT_RUN_GAME:
 		RunGame();
 		return 0;
+#ifdef CC_BUILD_BENCH
+	case ARG_RESULT_RUN_BENCH:
+		RunBenchmark();
+		return 0;
+#endif
 	default:
 		return 1;
 	}